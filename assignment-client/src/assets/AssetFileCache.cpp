@@ -0,0 +1,133 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <QtCore/QFileInfo>
+
+#include <NetworkLogging.h>
+
+MappedAssetFile::~MappedAssetFile() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+bool MappedAssetFile::map() {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    _size = _file.size();
+    if (_size == 0) {
+        // empty files cannot be mapped, but are valid assets
+        return true;
+    }
+
+    _data = _file.map(0, _size);
+
+    // the mapping outlives the file handle
+    _file.close();
+
+    return _data != nullptr;
+}
+
+void AssetFileCache::setFilesDirectory(const QDir& filesDirectory) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _filesDirectory = filesDirectory;
+}
+
+MappedAssetFilePointer AssetFileCache::get(const QString& hexHash) {
+    QString filePath;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _files.find(hexHash);
+        if (it != _files.end()) {
+            ++_numHits;
+
+            // move to the front of the LRU
+            _lru.splice(_lru.begin(), _lru, it.value());
+            return _lru.front().second;
+        }
+
+        filePath = _filesDirectory.filePath(hexHash);
+    }
+
+    ++_numMisses;
+
+    // map outside of the lock, so that hits are not held up by the disk
+    auto file = std::make_shared<MappedAssetFile>(filePath);
+    if (!file->map()) {
+        return nullptr;
+    }
+
+    if (file->getSize() > _maxSize) {
+        // too large to cache, this request keeps it mapped on its own
+        return file;
+    }
+
+    if (QFileInfo(filePath).size() != file->getSize()) {
+        // the file was replaced while being mapped, only cache the mapping of a settled file
+        qCDebug(networking) << "Not caching asset" << hexHash << "that changed while being mapped";
+        return file;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _files.find(hexHash);
+    if (it != _files.end()) {
+        // mapped by another request in the meantime
+        _lru.splice(_lru.begin(), _lru, it.value());
+        return _lru.front().second;
+    }
+
+    _lru.emplace_front(hexHash, file);
+    _files.insert(hexHash, _lru.begin());
+    _size += file->getSize();
+
+    evict();
+
+    return file;
+}
+
+void AssetFileCache::remove(const QString& hexHash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _files.find(hexHash);
+    if (it != _files.end()) {
+        _size -= it.value()->second->getSize();
+        _lru.erase(it.value());
+        _files.erase(it);
+    }
+}
+
+int AssetFileCache::getNumFiles() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int)_lru.size();
+}
+
+qint64 AssetFileCache::getSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+void AssetFileCache::evict() {
+    // the most recently used file is never evicted, it fits on its own
+    while (_size > _maxSize && _lru.size() > 1) {
+        auto& leastRecentlyUsed = _lru.back();
+
+        qCDebug(networking) << "Unmapping asset" << leastRecentlyUsed.first << "from the asset file cache";
+
+        _size -= leastRecentlyUsed.second->getSize();
+        _files.remove(leastRecentlyUsed.first);
+        _lru.pop_back();
+    }
+}
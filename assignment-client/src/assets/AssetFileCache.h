@@ -0,0 +1,84 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+// A memory-mapped asset file
+//   Asset files are named by the hash of their content, and uploads replace them atomically with a rename,
+//   so the mapping never goes stale while the file exists.
+class MappedAssetFile {
+public:
+    MappedAssetFile(const QString& filePath) : _file(filePath) {}
+    ~MappedAssetFile();
+
+    // returns false if the file does not exist or could not be mapped
+    bool map();
+
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+};
+
+using MappedAssetFilePointer = std::shared_ptr<const MappedAssetFile>;
+
+// LRU cache of memory-mapped asset files, bounded by their total size
+//   Thread-safe: it is shared by the AssetServer and its SendAssetTasks.
+//   Evicted files stay mapped until the last task using them is done.
+class AssetFileCache {
+public:
+    AssetFileCache(qint64 maxSize) : _maxSize(maxSize) {}
+
+    void setFilesDirectory(const QDir& filesDirectory);
+
+    // returns the mapped file for the asset with the given hex hash, or nullptr if there is none
+    MappedAssetFilePointer get(const QString& hexHash);
+
+    // drops the asset from the cache, so that its file can be removed
+    void remove(const QString& hexHash);
+
+    int getNumFiles() const;
+    qint64 getSize() const;
+    quint64 getNumHits() const { return _numHits; }
+    quint64 getNumMisses() const { return _numMisses; }
+
+private:
+    using LRU = std::list<std::pair<QString, MappedAssetFilePointer>>;
+
+    // requires _mutex
+    void evict();
+
+    const qint64 _maxSize;
+
+    mutable std::mutex _mutex;
+    QDir _filesDirectory;
+    LRU _lru; // most recently used first
+    QHash<QString, LRU::iterator> _files;
+    qint64 _size { 0 };
+
+    std::atomic<quint64> _numHits { 0 };
+    std::atomic<quint64> _numMisses { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
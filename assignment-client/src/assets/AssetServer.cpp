@@ -41,6 +41,9 @@ static const int INTERFACE_RUNNING_CHECK_FREQUENCY_MS = 1000;
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+// total size of the asset files kept memory-mapped for serving
+static const qint64 MAX_MAPPED_ASSET_FILES_SIZE = 512 * 1024 * 1024;
+
 bool interfaceRunning() {
     bool result = false;
 
@@ -74,6 +77,7 @@ void updateConsumedCores() {
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
+    _fileCache(MAX_MAPPED_ASSET_FILES_SIZE),
     _taskPool(this)
 {
 
@@ -177,6 +181,8 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    _fileCache.setFilesDirectory(_filesDirectory);
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qInfo() << "Serving files from: " << _filesDirectory.path();
@@ -215,6 +221,7 @@ void AssetServer::cleanupUnmappedFiles() {
         if (hashFileRegex.exactMatch(fileInfo.fileName())) {
             if (!mappedHashes.contains(fileInfo.fileName())) {
                 // remove the unmapped file
+                _fileCache.remove(fileInfo.fileName());
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -362,13 +369,12 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->writePrimitive(messageID);
     replyPacket->write(assetHash);
 
-    QString fileName = QString(hexHash);
-    QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+    // the file is most often requested right after its info, so map it now
+    auto file = _fileCache.get(QString(hexHash));
 
-    if (fileInfo.exists() && fileInfo.isReadable()) {
-        qDebug() << "Opening file: " << fileInfo.filePath();
+    if (file) {
         replyPacket->writePrimitive(AssetServerError::NoError);
-        replyPacket->writePrimitive(fileInfo.size());
+        replyPacket->writePrimitive(file->getSize());
     } else {
         qDebug() << "Asset not found: " << QString(hexHash);
         replyPacket->writePrimitive(AssetServerError::AssetNotFound);
@@ -388,7 +394,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _fileCache);
     _taskPool.start(task);
 }
 
@@ -397,7 +403,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (senderNode->getCanWriteToAssetServer()) {
         qDebug() << "Starting an UploadAssetTask for upload from" << uuidStringWithoutCurlyBraces(senderNode->getUUID());
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _fileCache);
         _taskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -484,6 +490,13 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    QJsonObject fileCacheStats;
+    fileCacheStats["1. Files"] = _fileCache.getNumFiles();
+    fileCacheStats["2. Size (MB)"] = (double)_fileCache.getSize() / (1024 * 1024);
+    fileCacheStats["3. Hits"] = (double)_fileCache.getNumHits();
+    fileCacheStats["4. Misses"] = (double)_fileCache.getNumMisses();
+    serverStats["File Cache"] = fileCacheStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -669,6 +682,7 @@ bool AssetServer::deleteMappings(AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            _fileCache.remove(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -17,6 +17,7 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -67,6 +68,9 @@ private:
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+
+    // declared before the task pool, which waits for its tasks as it is destroyed
+    AssetFileCache _fileCache;
     QThreadPool _taskPool;
 };
 
@@ -13,19 +13,22 @@
 
 #include <QtCore/QBuffer>
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
 
+#include "AssetFileCache.h"
 #include "ClientServerUtils.h"
 
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir) :
+                                 const QDir& resourcesDir, AssetFileCache& fileCache) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _fileCache(fileCache)
 {
     
 }
@@ -59,9 +62,11 @@ void UploadAssetTask::run() {
         qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID())
             << "is: (" << hexHash << ") ";
         
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
+        QString filePath = _resourcesDir.filePath(QString(hexHash));
+        QFile file { filePath };
 
         bool existingCorrectFile = false;
+        bool existingBadFile = false;
         
         if (file.exists()) {
             // check if the local file has the correct contents, otherwise we overwrite
@@ -74,25 +79,33 @@ void UploadAssetTask::run() {
                 replyPacket->write(hash);
             } else {
                 qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
+                existingBadFile = true;
             }
+            file.close();
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            // write to a temporary file renamed over the asset once complete, so that the file cache
+            // can never map a partly written asset, nor have a mapped file truncated from under it
+            QSaveFile saveFile { filePath };
+            if (saveFile.open(QIODevice::WriteOnly) && saveFile.write(fileData) == qint64(fileSize) && saveFile.commit()) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
+
+                // stop serving the bad contents, now that the file has been replaced
+                _fileCache.remove(QString(hexHash));
 
                 replyPacket->writePrimitive(AssetServerError::NoError);
                 replyPacket->write(hash);
             } else {
                 qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+                saveFile.cancelWriting();
+
+                // upload has failed - remove the bad file and return an error
+                if (existingBadFile) {
+                    _fileCache.remove(QString(hexHash));
+                    if (!file.remove()) {
+                        qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+                    }
                 }
                 
                 replyPacket->writePrimitive(AssetServerError::FileOperationFailed);
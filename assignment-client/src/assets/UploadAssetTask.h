@@ -21,12 +21,14 @@
 
 #include "ReceivedMessage.h"
 
+class AssetFileCache;
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
-    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir);
+    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, const QDir& resourcesDir,
+                    AssetFileCache& fileCache);
 
     void run() override;
 
@@ -34,6 +36,7 @@ private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
+    AssetFileCache& _fileCache;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -47,6 +47,7 @@ static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 int AudioMixer::_numStaticJitterFrames{ -1 };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
+float AudioMixer::_farFieldDistance{ 0.0f };
 std::map<QString, std::shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
@@ -79,7 +80,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::RadiusIgnoreRequest,
             PacketType::RequestsDomainListData,
             PacketType::PerAvatarGainSet },
-            this, "queueAudioPacket");
+            this, &AudioMixer::queueAudioPacket);
 
     // packets whose consequences are global should be processed on the main thread
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
@@ -278,9 +279,13 @@ void AudioMixer::sendStatsPacket() {
     mixStats["%_hrtf_throttle_mixes"] = percentageForMixStats(_stats.hrtfThrottleRenders);
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+    mixStats["%_hrtf_cluster_mixes"] = percentageForMixStats(_stats.hrtfClusterMixes);
 
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
+    mixStats["audibility_radius"] = _audibilityRadius;
+    mixStats["avg_culled_nodes_per_frame"] = _stats.culledNodes / _numStatFrames;
+    mixStats["avg_cluster_renders_per_frame"] = _stats.hrtfClusterRenders / _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
@@ -351,6 +356,11 @@ void AudioMixer::start() {
         parseSettingsObject(settingsObject);
     }
 
+    _audibilityRadius = computeAudibilityRadius();
+    if (_audibilityRadius > 0.0f) {
+        qDebug() << "Culling streams beyond" << _audibilityRadius << "meters";
+    }
+
     // mix state
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
@@ -373,12 +383,16 @@ void AudioMixer::start() {
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     _stats.sumStreams += prepareFrame(node, frame);
                 });
+
+                // publish the popped streams to the slaves, and index them so slaves only visit audible sources
+                _streamSnapshot.build(cbegin, cend);
+                _spatialIndex.build(_streamSnapshot, _audibilityRadius);
             }
 
             // mix across slave threads
             {
                 auto mixTimer = _mixTiming.timer();
-                _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
+                _slavePool.mix(cbegin, cend, frame, _throttlingRatio, _streamSnapshot, _spatialIndex);
             }
         });
 
@@ -490,6 +504,16 @@ int AudioMixer::prepareFrame(const SharedNodePointer& node, unsigned int frame)
     return data->checkBuffersBeforeFrameSend();
 }
 
+float AudioMixer::computeAudibilityRadius() {
+    // zone coefficients override the attenuation for some pairs, so use the least attenuating
+    float attenuationPerDoublingInDistance = _attenuationPerDoublingInDistance;
+    for (int i = 0; i < _zoneSettings.length(); ++i) {
+        attenuationPerDoublingInDistance = std::min(attenuationPerDoublingInDistance, _zoneSettings[i].coefficient);
+    }
+
+    return AudioMixerSpatialIndex::computeAudibilityRadius(attenuationPerDoublingInDistance);
+}
+
 void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
     qDebug() << "AVX2 Support:" << (cpuSupportsAVX2() ? "enabled" : "disabled");
 
@@ -591,6 +615,16 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             }
         }
 
+        const QString FAR_FIELD_DISTANCE = "far_field_distance";
+        if (audioEnvGroupObject[FAR_FIELD_DISTANCE].isString()) {
+            bool ok = false;
+            float farFieldDistance = audioEnvGroupObject[FAR_FIELD_DISTANCE].toString().toFloat(&ok);
+            if (ok && farFieldDistance >= 0.0f) {
+                _farFieldDistance = farFieldDistance;
+                qDebug() << "Far-field clustering distance changed to" << _farFieldDistance;
+            }
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
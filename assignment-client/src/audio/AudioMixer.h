@@ -20,6 +20,8 @@
 
 #include "AudioMixerStats.h"
 #include "AudioMixerSlavePool.h"
+#include "AudioMixerSpatialIndex.h"
+#include "AudioMixerStreamSnapshot.h"
 
 class PositionalAudioStream;
 class AvatarAudioStream;
@@ -46,6 +48,7 @@ public:
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
+    static float getFarFieldDistance() { return _farFieldDistance; }
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
@@ -73,6 +76,8 @@ private:
     // pop a frame from any streams on the node
     // returns the number of available streams
     int prepareFrame(const SharedNodePointer& node, unsigned int frame);
+    // returns the audibility radius for the most permissive of the attenuation settings (0 if unbounded)
+    float computeAudibilityRadius();
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
@@ -90,6 +95,10 @@ private:
 
     AudioMixerSlavePool _slavePool;
 
+    AudioMixerStreamSnapshot _streamSnapshot;
+    AudioMixerSpatialIndex _spatialIndex;
+    float _audibilityRadius { 0.0f };
+
     class Timer {
     public:
         class Timing{
@@ -122,6 +131,7 @@ private:
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
+    static float _farFieldDistance; // 0 disables far-field clustering
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
     static QHash<QString, AABox> _audioZones;
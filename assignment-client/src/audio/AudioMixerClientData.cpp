@@ -161,6 +161,24 @@ void AudioMixerClientData::removeHRTFForStream(const QUuid& nodeID, const QUuid&
     }
 }
 
+AudioHRTF& AudioMixerClientData::hrtfForCluster(uint64_t clusterKey, unsigned int frame) {
+    auto& cluster = _clusterHRTFMap[clusterKey];
+    cluster.frame = frame;
+    return cluster.hrtf;
+}
+
+void AudioMixerClientData::removeUnusedClusterHRTFs(unsigned int frame, std::function<void(AudioHRTF& hrtf)> flush) {
+    auto it = _clusterHRTFMap.begin();
+    while (it != _clusterHRTFMap.end()) {
+        if (it->second.frame != frame) {
+            flush(it->second.hrtf);
+            it = _clusterHRTFMap.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void AudioMixerClientData::removeAgentAvatarAudioStream() {
     QWriteLocker writeLocker { &_streamsLock };
     auto it = _audioStreams.find(QUuid());
@@ -12,6 +12,7 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <functional>
 #include <queue>
 
 #include <QtCore/QJsonObject>
@@ -41,6 +42,14 @@ public:
 
     // locks the mutex to make a copy
     AudioStreamMap getAudioStreams() { QReadLocker readLock { &_streamsLock }; return _audioStreams; }
+    // locks the mutex to iterate without a copy
+    template <typename StreamFunctor>
+    void eachAudioStream(StreamFunctor functor) {
+        QReadLocker readLock { &_streamsLock };
+        for (auto& streamPair : _audioStreams) {
+            functor(*streamPair.second);
+        }
+    }
     AvatarAudioStream* getAvatarAudioStream();
 
     // returns whether self (this data's node) should ignore node, memoized by frame
@@ -56,6 +65,12 @@ public:
     // removes an AudioHRTF object for a given stream
     void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
 
+    // returns a new or existing HRTF object for the given far-field cluster, marking it used in frame
+    AudioHRTF& hrtfForCluster(uint64_t clusterKey, unsigned int frame);
+
+    // flushes (with the given functor) and removes the cluster HRTF objects not used in frame
+    void removeUnusedClusterHRTFs(unsigned int frame, std::function<void(AudioHRTF& hrtf)> flush);
+
     // remove all sources and data from this node
     void removeNode(const QUuid& nodeID) { _nodeSourcesIgnoreMap.unsafe_erase(nodeID); _nodeSourcesHRTFMap.erase(nodeID); }
 
@@ -166,6 +181,13 @@ private:
     using NodeSourcesHRTFMap = std::unordered_map<QUuid, HRTFMap>;
     NodeSourcesHRTFMap _nodeSourcesHRTFMap;
 
+    struct ClusterHRTF {
+        AudioHRTF hrtf;
+        unsigned int frame { 0 };
+    };
+    using ClusterHRTFMap = std::unordered_map<uint64_t, ClusterHRTF>;
+    ClusterHRTFMap _clusterHRTFMap;
+
     quint16 _outgoingMixedAudioSequenceNumber;
 
     AudioStreamStats _downstreamAudioStreamStats;
@@ -30,14 +30,21 @@
 #include "AudioRingBuffer.h"
 #include "AudioMixer.h"
 #include "AudioMixerClientData.h"
+#include "AudioMixerSpatialIndex.h"
 #include "AvatarAudioStream.h"
-#include "InjectedAudioStream.h"
 #include "AudioHelpers.h"
 
 #include "AudioMixerSlave.h"
 
 using AudioStreamMap = AudioMixerClientData::AudioStreamMap;
 
+static const int HRTF_DATASET_INDEX = 1;
+
+// far-field clusters are sized so that they span a small angle as heard by the listener
+static const float FAR_FIELD_CLUSTERS_PER_DISTANCE = 5.0f;
+
+static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+
 // packet helpers
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
 void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
@@ -46,9 +53,9 @@ void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
-inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const AudioMixerStreamSnapshot::Stream& streamToAdd,
         const glm::vec3& relativePosition);
-inline float computeGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+inline float computeGain(const AvatarAudioStream& listeningNodeStream, const AudioMixerStreamSnapshot::Stream& streamToAdd,
         const glm::vec3& relativePosition, bool isEcho);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
@@ -60,11 +67,14 @@ void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        const AudioMixerStreamSnapshot* streamSnapshot, const AudioMixerSpatialIndex* spatialIndex) {
     _begin = begin;
     _end = end;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _streamSnapshot = streamSnapshot;
+    _spatialIndex = spatialIndex;
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -129,15 +139,14 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
     bool isThrottling = _throttlingRatio > 0.0f;
-    std::vector<std::pair<float, SharedNodePointer>> throttledNodes;
+    std::vector<std::pair<float, int>> throttledNodes;
 
     typedef void (AudioMixerSlave::*MixFunctor)(
-            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&);
-    auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, MixFunctor mixFunctor) {
-        auto nodeID = node->getUUID();
-        for (auto& streamPair : nodeData->getAudioStreams()) {
-            auto nodeStream = streamPair.second;
-            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *nodeStream);
+            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const MixableStream&);
+    auto forAllStreams = [&](const AudioMixerStreamSnapshot::Node& node, MixFunctor mixFunctor) {
+        auto streamsEnd = _streamSnapshot->streamsEnd(node);
+        for (auto nodeStream = _streamSnapshot->streamsBegin(node); nodeStream != streamsEnd; ++nodeStream) {
+            (this->*mixFunctor)(*listenerData, node.nodeID, *listenerAudioStream, *nodeStream);
         }
     };
 
@@ -145,55 +154,69 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     auto mixStart = p_high_resolution_clock::now();
 #endif
 
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-        if (!nodeData) {
+    auto mixNode = [&](int nodeIndex) {
+        auto& snapshotNode = _streamSnapshot->getNode(nodeIndex);
+        if (snapshotNode.numStreams == 0) {
             return;
         }
 
+        const SharedNodePointer& node = *(_begin + nodeIndex);
+
         if (*node == *listener) {
             // only mix the echo, if requested
-            for (auto& streamPair : nodeData->getAudioStreams()) {
-                auto nodeStream = streamPair.second;
-                if (nodeStream->shouldLoopbackForNode()) {
-                    mixStream(*listenerData, node->getUUID(), *listenerAudioStream, *nodeStream);
+            auto streamsEnd = _streamSnapshot->streamsEnd(snapshotNode);
+            for (auto nodeStream = _streamSnapshot->streamsBegin(snapshotNode); nodeStream != streamsEnd; ++nodeStream) {
+                if (nodeStream->shouldLoopback) {
+                    mixStream(*listenerData, snapshotNode.nodeID, *listenerAudioStream, *nodeStream);
                 }
             }
         } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
             if (!isThrottling) {
-                forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+                forAllStreams(snapshotNode, &AudioMixerSlave::mixStream);
             } else {
-                auto nodeID = node->getUUID();
-
                 // compute the node's max relative volume
-                float nodeVolume;
-                for (auto& streamPair : nodeData->getAudioStreams()) {
-                    auto nodeStream = streamPair.second;
-
+                float nodeVolume = 0.0f;
+                auto streamsEnd = _streamSnapshot->streamsEnd(snapshotNode);
+                for (auto nodeStream = _streamSnapshot->streamsBegin(snapshotNode); nodeStream != streamsEnd; ++nodeStream) {
                     // approximate the gain
-                    glm::vec3 relativePosition = nodeStream->getPosition() - listenerAudioStream->getPosition();
+                    glm::vec3 relativePosition = nodeStream->position - listenerAudioStream->getPosition();
                     float gain = approximateGain(*listenerAudioStream, *nodeStream, relativePosition);
 
                     // modify by hrtf gain adjustment
-                    auto& hrtf = listenerData->hrtfForStream(nodeID, nodeStream->getStreamIdentifier());
+                    auto& hrtf = listenerData->hrtfForStream(snapshotNode.nodeID, nodeStream->streamID);
                     gain *= hrtf.getGainAdjustment();
 
-                    auto streamVolume = nodeStream->getLastPopOutputTrailingLoudness() * gain;
+                    auto streamVolume = nodeStream->lastPopOutputTrailingLoudness * gain;
                     nodeVolume = std::max(streamVolume, nodeVolume);
                 }
 
                 // max-heapify the nodes by relative volume
-                throttledNodes.push_back(std::make_pair(nodeVolume, node));
+                throttledNodes.push_back(std::make_pair(nodeVolume, nodeIndex));
                 if (!throttledNodes.empty()) {
                     std::push_heap(throttledNodes.begin(), throttledNodes.end());
                 }
             }
         }
-    });
+    };
+
+    int numNodes = _streamSnapshot->getNumNodes();
+    if (_spatialIndex && _spatialIndex->isBounded()) {
+        // only visit nodes with a stream inside the audibility radius; the rest are inaudible
+        _spatialIndex->findAudibleNodes(listenerAudioStream->getPosition(), _audibleNodes);
+        for (int nodeIndex : _audibleNodes) {
+            mixNode(nodeIndex);
+        }
+
+        stats.culledNodes += numNodes - (int)_audibleNodes.size();
+    } else {
+        for (int nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex) {
+            mixNode(nodeIndex);
+        }
+    }
 
     if (isThrottling) {
         // pop the loudest nodes off the heap and mix their streams
-        int numToRetain = (int)(std::distance(_begin, _end) * (1 - _throttlingRatio));
+        int numToRetain = (int)(numNodes * (1 - _throttlingRatio));
         for (int i = 0; i < numToRetain; i++) {
             if (throttledNodes.empty()) {
                 break;
@@ -201,21 +224,23 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
             std::pop_heap(throttledNodes.begin(), throttledNodes.end());
 
-            auto& node = throttledNodes.back().second;
-            AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-            forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+            forAllStreams(_streamSnapshot->getNode(throttledNodes.back().second), &AudioMixerSlave::mixStream);
 
             throttledNodes.pop_back();
         }
 
         // throttle the remaining nodes' streams
-        for (const std::pair<float, SharedNodePointer>& nodePair : throttledNodes) {
-            auto& node = nodePair.second;
-            AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-            forAllStreams(node, nodeData, &AudioMixerSlave::throttleStream);
+        for (const std::pair<float, int>& nodePair : throttledNodes) {
+            forAllStreams(_streamSnapshot->getNode(nodePair.second), &AudioMixerSlave::throttleStream);
         }
     }
 
+    // render the far-field clusters gathered from the streams above
+    mixClusters(*listenerData, *listenerAudioStream);
+
+    // render all HRTFs of the listener in one batch
+    renderBatch();
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
@@ -239,17 +264,17 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 }
 
 void AudioMixerSlave::throttleStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+        const AvatarAudioStream& listeningNodeStream, const MixableStream& streamToAdd) {
     addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, true);
 }
 
 void AudioMixerSlave::mixStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
+        const AvatarAudioStream& listeningNodeStream, const MixableStream& streamToAdd) {
     addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, false);
 }
 
 void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+        const AvatarAudioStream& listeningNodeStream, const MixableStream& streamToAdd,
         bool throttle) {
     ++stats.totalMixes;
 
@@ -257,26 +282,25 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     // this ensures the correct tail from last mixed block and the correct spatialization of next first block
 
     // check if this is a server echo of a source back to itself
-    bool isEcho = (&streamToAdd == &listeningNodeStream);
+    bool isEcho = (streamToAdd.stream == &listeningNodeStream);
 
-    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
+    glm::vec3 relativePosition = streamToAdd.position - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho);
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
-    const int HRTF_DATASET_INDEX = 1;
 
-    if (!streamToAdd.lastPopSucceeded()) {
+    if (!streamToAdd.lastPopSucceeded) {
         bool forceSilentBlock = true;
 
-        if (!streamToAdd.getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(&streamToAdd);
+        if (!streamToAdd.lastPopOutput.isNull()) {
+            bool isInjector = (streamToAdd.type == PositionalAudioStream::Injector);
 
             // in an injector, just go silent - the injector has likely ended
             // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
             if (!isInjector) {
                 // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
+                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd.consecutiveNotMixedCount - 1);
                 if (fadeFactor > 0.0f) {
                     // apply the fadeFactor to the gain
                     gain *= fadeFactor;
@@ -288,11 +312,10 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
         if (forceSilentBlock) {
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
-            if (!streamToAdd.isStereo() && !isEcho) {
+            if (!streamToAdd.isStereo && !isEcho) {
                 // get the existing listener-source HRTF object, or create a new one
-                auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+                auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.streamID);
 
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
                 hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
@@ -304,10 +327,10 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     }
 
     // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
+    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.lastPopOutput;
 
     // stereo sources are not passed through HRTF
-    if (streamToAdd.isStereo()) {
+    if (streamToAdd.isStereo) {
         for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
             _mixSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
         }
@@ -329,11 +352,11 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     }
 
     // get the existing listener-source HRTF object, or create a new one
-    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.streamID);
 
     streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-    if (streamToAdd.getLastPopOutputLoudness() == 0.0f) {
+    if (streamToAdd.lastPopOutputLoudness == 0.0f) {
         // call renderSilent to reduce artifacts
         hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -351,12 +374,104 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
         return;
     }
 
-    hrtf.render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    float farFieldDistance = AudioMixer::getFarFieldDistance();
+    if (farFieldDistance > 0.0f && distance > farFieldDistance) {
+        // flush the source's own HRTF (this is only a full render on the first far frame)
+        hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        // and share a single HRTF with the other sources of its cluster
+        addToCluster(streamToAdd.position, _bufferSamples, gain * hrtf.getGainAdjustment(),
+                     farFieldDistance / FAR_FIELD_CLUSTERS_PER_DISTANCE);
+
+        ++stats.hrtfClusterMixes;
+        return;
+    }
+
+    addToBatch(hrtf, _bufferSamples, azimuth, distance, gain);
 
     ++stats.hrtfRenders;
 }
 
+void AudioMixerSlave::addToCluster(const glm::vec3& position, const int16_t* samples, float gain, float cellSize) {
+    auto key = AudioMixerSpatialIndex::keyForPosition(position, cellSize);
+
+    auto it = _clusterIndices.find(key);
+    if (it == _clusterIndices.end()) {
+        it = _clusterIndices.emplace(key, (int)_clusters.size()).first;
+        _clusters.push_back(FarFieldCluster());
+        _clusters.back().key = key;
+    }
+
+    auto& cluster = _clusters[it->second];
+    cluster.positionSum += position;
+    ++cluster.numSources;
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+        cluster.samples[i] += samples[i] * gain;
+    }
+}
+
+void AudioMixerSlave::mixClusters(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream) {
+    for (auto& cluster : _clusters) {
+        // the cluster is heard from the centroid of its sources
+        glm::vec3 position = cluster.positionSum / (float)cluster.numSources;
+        glm::vec3 relativePosition = position - listenerStream.getPosition();
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+        float azimuth = computeAzimuth(listenerStream, listenerStream, relativePosition);
+
+        // the down-mix is already attenuated, so quantize it for the HRTF as-is
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++i) {
+            float sample = glm::clamp(cluster.samples[i], (float)AudioConstants::MIN_SAMPLE_VALUE,
+                                      (float)AudioConstants::MAX_SAMPLE_VALUE);
+            _bufferSamples[i] = (int16_t)lrintf(sample);
+        }
+
+        auto& hrtf = listenerData.hrtfForCluster(cluster.key, _frame);
+        addToBatch(hrtf, _bufferSamples, azimuth, distance, 1.0f);
+
+        ++stats.hrtfClusterRenders;
+    }
+
+    // flush the tails of clusters that emptied since the last frame
+    listenerData.removeUnusedClusterHRTFs(_frame, [&](AudioHRTF& hrtf) {
+        hrtf.renderSilent(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, 0.0f, 1.0f, 0.0f,
+                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    });
+
+    _clusters.clear();
+    _clusterIndices.clear();
+}
+
+void AudioMixerSlave::addToBatch(AudioHRTF& hrtf, const int16_t* samples, float azimuth, float distance, float gain) {
+    _batchHRTFs.push_back(&hrtf);
+    _batchSamples.insert(_batchSamples.end(), samples, samples + AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    _batchAzimuths.push_back(azimuth);
+    _batchDistances.push_back(distance);
+    _batchGains.push_back(gain);
+}
+
+void AudioMixerSlave::renderBatch() {
+    int numSources = (int)_batchHRTFs.size();
+
+    // the samples may have been reallocated while batching, so point into them only now
+    _batchInputs.resize(numSources);
+    for (int i = 0; i < numSources; ++i) {
+        _batchInputs[i] = &_batchSamples[i * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    }
+
+    AudioHRTF::renderBatch(_batchHRTFs.data(), _batchInputs.data(), _mixSamples, HRTF_DATASET_INDEX,
+                           _batchAzimuths.data(), _batchDistances.data(), _batchGains.data(),
+                           numSources, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    _batchHRTFs.clear();
+    _batchSamples.clear();
+    _batchInputs.clear();
+    _batchAzimuths.clear();
+    _batchDistances.clear();
+    _batchGains.clear();
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -463,13 +578,13 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     }
 }
 
-float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+float approximateGain(const AvatarAudioStream& listeningNodeStream, const AudioMixerStreamSnapshot::Stream& streamToAdd,
         const glm::vec3& relativePosition) {
     float gain = 1.0f;
 
     // injector: apply attenuation
-    if (streamToAdd.getType() == PositionalAudioStream::Injector) {
-        gain *= reinterpret_cast<const InjectedAudioStream*>(&streamToAdd)->getAttenuationRatio();
+    if (streamToAdd.type == PositionalAudioStream::Injector) {
+        gain *= streamToAdd.attenuationRatio;
     }
 
     // avatar: skip attenuation - it is too costly to approximate
@@ -482,17 +597,17 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
     return gain / distance;
 }
 
-float computeGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+float computeGain(const AvatarAudioStream& listeningNodeStream, const AudioMixerStreamSnapshot::Stream& streamToAdd,
         const glm::vec3& relativePosition, bool isEcho) {
     float gain = 1.0f;
 
     // injector: apply attenuation
-    if (streamToAdd.getType() == PositionalAudioStream::Injector) {
-        gain *= reinterpret_cast<const InjectedAudioStream*>(&streamToAdd)->getAttenuationRatio();
+    if (streamToAdd.type == PositionalAudioStream::Injector) {
+        gain *= streamToAdd.attenuationRatio;
 
     // avatar: apply fixed off-axis attenuation to make them quieter as they turn away
-    } else if (!isEcho && (streamToAdd.getType() == PositionalAudioStream::Microphone)) {
-        glm::vec3 rotatedListenerPosition = glm::inverse(streamToAdd.getOrientation()) * relativePosition;
+    } else if (!isEcho && (streamToAdd.type == PositionalAudioStream::Microphone)) {
+        glm::vec3 rotatedListenerPosition = glm::inverse(streamToAdd.orientation) * relativePosition;
         float angleOfDelivery = glm::angle(glm::vec3(0.0f, 0.0f, -1.0f),
                                            glm::normalize(rotatedListenerPosition));
 
@@ -510,7 +625,7 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
     // find distance attenuation coefficient
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (int i = 0; i < zoneSettings.length(); ++i) {
-        if (audioZones[zoneSettings[i].source].contains(streamToAdd.getPosition()) &&
+        if (audioZones[zoneSettings[i].source].contains(streamToAdd.position) &&
             audioZones[zoneSettings[i].listener].contains(listeningNodeStream.getPosition())) {
             attenuationPerDoublingInDistance = zoneSettings[i].coefficient;
             break;
@@ -12,6 +12,9 @@
 #ifndef hifi_AudioMixerSlave_h
 #define hifi_AudioMixerSlave_h
 
+#include <unordered_map>
+#include <vector>
+
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
@@ -20,7 +23,9 @@
 #include <NodeList.h>
 
 #include "AudioMixerStats.h"
+#include "AudioMixerStreamSnapshot.h"
 
+class AudioMixerSpatialIndex;
 class PositionalAudioStream;
 class AvatarAudioStream;
 class AudioHRTF;
@@ -34,7 +39,8 @@ public:
     void processPackets(const SharedNodePointer& node);
 
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            const AudioMixerStreamSnapshot* streamSnapshot, const AudioMixerSpatialIndex* spatialIndex);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
@@ -45,14 +51,25 @@ public:
 private:
     // create mix, returns true if mix has audio
     bool prepareMix(const SharedNodePointer& listener);
+    using MixableStream = AudioMixerStreamSnapshot::Stream;
     void throttleStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+            const AvatarAudioStream& listenerStream, const MixableStream& streamer);
     void mixStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+            const AvatarAudioStream& listenerStream, const MixableStream& streamer);
     void addStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
+            const AvatarAudioStream& listenerStream, const MixableStream& streamer,
             bool throttle);
 
+    // down-mix a source into the far-field cluster containing its position
+    void addToCluster(const glm::vec3& position, const int16_t* samples, float gain, float cellSize);
+    // render one HRTF per far-field cluster into the mix
+    void mixClusters(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream);
+
+    // defer an HRTF render to the batch of the current listener
+    void addToBatch(AudioHRTF& hrtf, const int16_t* samples, float azimuth, float distance, float gain);
+    // render the batched HRTFs into the mix
+    void renderBatch();
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
@@ -62,6 +79,29 @@ private:
     ConstIter _end;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    const AudioMixerStreamSnapshot* _streamSnapshot { nullptr };
+    const AudioMixerSpatialIndex* _spatialIndex { nullptr };
+
+    // indices of the audible nodes for the current listener (reused across listeners)
+    std::vector<int> _audibleNodes;
+
+    // far-field clusters for the current listener (reused across listeners)
+    struct FarFieldCluster {
+        uint64_t key;
+        glm::vec3 positionSum;
+        int numSources;
+        float samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    };
+    std::vector<FarFieldCluster> _clusters;
+    std::unordered_map<uint64_t, int> _clusterIndices;
+
+    // batched HRTF renders for the current listener (reused across listeners)
+    std::vector<AudioHRTF*> _batchHRTFs;
+    std::vector<int16_t> _batchSamples;
+    std::vector<int16_t*> _batchInputs;
+    std::vector<float> _batchAzimuths;
+    std::vector<float> _batchDistances;
+    std::vector<float> _batchGains;
 };
 
 #endif // hifi_AudioMixerSlave_h
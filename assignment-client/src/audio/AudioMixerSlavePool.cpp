@@ -74,13 +74,16 @@ void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     run(begin, end);
 }
 
-void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        const AudioMixerStreamSnapshot& streamSnapshot, const AudioMixerSpatialIndex& spatialIndex) {
     _function = &AudioMixerSlave::mix;
     _configure = [&](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, _frame, _throttlingRatio);
+        slave.configureMix(_begin, _end, _frame, _throttlingRatio, _streamSnapshot, _spatialIndex);
     };
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _streamSnapshot = &streamSnapshot;
+    _spatialIndex = &spatialIndex;
 
     run(begin, end);
 }
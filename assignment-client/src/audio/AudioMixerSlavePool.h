@@ -65,7 +65,8 @@ public:
     void processPackets(ConstIter begin, ConstIter end);
 
     // mix on slave threads
-    void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            const AudioMixerStreamSnapshot& streamSnapshot, const AudioMixerSpatialIndex& spatialIndex);
 
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
@@ -98,6 +99,8 @@ private:
     Queue _queue;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    const AudioMixerStreamSnapshot* _streamSnapshot { nullptr };
+    const AudioMixerSpatialIndex* _spatialIndex { nullptr };
     ConstIter _begin;
     ConstIter _end;
 };
@@ -0,0 +1,115 @@
+//
+//  AudioMixerSpatialIndex.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <assert.h>
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtx/norm.hpp>
+
+#include <NumericalConstants.h>
+#include <OctreeConstants.h>
+
+#include "AudioMixerSpatialIndex.h"
+
+// gain below which a stream cannot be heard (-90dB, below the LSB of the 16-bit mix)
+static const float MIN_AUDIBLE_GAIN = 1.0f / 32768.0f;
+
+// distances are attenuated from this distance onward (matches computeGain in AudioMixerSlave)
+static const float ATTENUATION_START_DISTANCE = 1.0f;
+
+// radii larger than the domain cannot cull anything
+static const float MAX_AUDIBILITY_RADIUS = (float)TREE_SCALE;
+
+// cell coordinates are packed into 21 bits per axis
+static const int CELL_BITS = 21;
+static const int CELL_OFFSET = 1 << (CELL_BITS - 1);
+static const int CELL_MAX = (1 << CELL_BITS) - 1;
+
+float AudioMixerSpatialIndex::computeAudibilityRadius(float attenuationPerDoublingInDistance) {
+    // translate the setting to gain per log2(distance), as in computeGain
+    float g = 1.0f - attenuationPerDoublingInDistance;
+    g = glm::clamp(g, EPSILON, 1.0f);
+
+    if (g >= 1.0f) {
+        // no distance attenuation
+        return 0.0f;
+    }
+
+    // solve g^log2(distance) = MIN_AUDIBLE_GAIN for distance
+    float radius = ATTENUATION_START_DISTANCE * exp2f(log2f(MIN_AUDIBLE_GAIN) / log2f(g));
+    if (radius > MAX_AUDIBILITY_RADIUS) {
+        return 0.0f;
+    }
+
+    return std::max(radius, ATTENUATION_START_DISTANCE);
+}
+
+void AudioMixerSpatialIndex::build(const AudioMixerStreamSnapshot& snapshot, float audibilityRadius) {
+    _entries.clear();
+    _audibilityRadius = audibilityRadius;
+
+    if (!isBounded()) {
+        return;
+    }
+
+    _inverseCellSize = 1.0f / _audibilityRadius;
+
+    auto& streams = snapshot.getStreams();
+    for (int i = 0; i < (int)streams.size(); ++i) {
+        const glm::vec3& position = streams[i].position;
+        _entries.push_back({ keyForCell(cellForPosition(position)), snapshot.getNodeIndex(i), position });
+    }
+
+    // stable, so that entries of a cell stay in node order
+    std::stable_sort(_entries.begin(), _entries.end());
+}
+
+void AudioMixerSpatialIndex::findAudibleNodes(const glm::vec3& position, std::vector<int>& nodes) const {
+    assert(isBounded());
+
+    nodes.clear();
+
+    const float radiusSquared = _audibilityRadius * _audibilityRadius;
+    const glm::ivec3 center = cellForPosition(position);
+
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int z = -1; z <= 1; ++z) {
+                Entry key { keyForCell(center + glm::ivec3(x, y, z)), 0, position };
+
+                auto range = std::equal_range(_entries.cbegin(), _entries.cend(), key);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (glm::distance2(it->position, position) <= radiusSquared) {
+                        nodes.push_back(it->node);
+                    }
+                }
+            }
+        }
+    }
+
+    // nodes with several streams may be found more than once
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+}
+
+AudioMixerSpatialIndex::CellKey AudioMixerSpatialIndex::keyForPosition(const glm::vec3& position, float cellSize) {
+    return keyForCell(glm::ivec3(glm::floor(position / cellSize)));
+}
+
+glm::ivec3 AudioMixerSpatialIndex::cellForPosition(const glm::vec3& position) const {
+    return glm::ivec3(glm::floor(position * _inverseCellSize));
+}
+
+AudioMixerSpatialIndex::CellKey AudioMixerSpatialIndex::keyForCell(const glm::ivec3& cell) {
+    // clamping is monotonic, so neighboring cells remain neighbors (entries are still distance-checked)
+    glm::ivec3 offset = glm::clamp(cell + glm::ivec3(CELL_OFFSET), glm::ivec3(0), glm::ivec3(CELL_MAX));
+    return ((CellKey)offset.x << (2 * CELL_BITS)) | ((CellKey)offset.y << CELL_BITS) | (CellKey)offset.z;
+}
@@ -0,0 +1,64 @@
+//
+//  AudioMixerSpatialIndex.h
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSpatialIndex_h
+#define hifi_AudioMixerSpatialIndex_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AudioMixerStreamSnapshot.h"
+
+// Spatial index of audio streams for a single mix frame
+//   The index is a uniform grid with cells sized to the audibility radius,
+//   so any audible stream lies in one of the 27 cells around a listener.
+//   It is built by the AudioMixer before mixing, and is read-only (thread-safe) while the slaves mix.
+class AudioMixerSpatialIndex {
+public:
+    using CellKey = uint64_t;
+
+    // returns the distance beyond which a stream is inaudible for the given attenuation per doubling in distance
+    // returns 0 if streams are audible at any distance
+    static float computeAudibilityRadius(float attenuationPerDoublingInDistance);
+
+    // rebuild the index over the streams of the snapshot
+    // an audibilityRadius of 0 leaves the index unbounded (no culling)
+    void build(const AudioMixerStreamSnapshot& snapshot, float audibilityRadius);
+
+    // returns true if the index can cull streams
+    bool isBounded() const { return _audibilityRadius > 0.0f; }
+    float getAudibilityRadius() const { return _audibilityRadius; }
+
+    // fills nodes with the indices (into the snapshot, in order) of nodes with a stream audible from position
+    // precondition: isBounded()
+    void findAudibleNodes(const glm::vec3& position, std::vector<int>& nodes) const;
+
+    // returns the key of the cell of the given size containing position
+    static CellKey keyForPosition(const glm::vec3& position, float cellSize);
+
+private:
+    struct Entry {
+        CellKey cell;
+        int node;
+        glm::vec3 position;
+
+        bool operator<(const Entry& other) const { return cell < other.cell; }
+    };
+
+    glm::ivec3 cellForPosition(const glm::vec3& position) const;
+    static CellKey keyForCell(const glm::ivec3& cell);
+
+    std::vector<Entry> _entries; // sorted by cell
+    float _audibilityRadius { 0.0f };
+    float _inverseCellSize { 0.0f };
+};
+
+#endif // hifi_AudioMixerSpatialIndex_h
@@ -19,8 +19,11 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfSilentRenders = 0;
     hrtfThrottleRenders = 0;
+    hrtfClusterMixes = 0;
+    hrtfClusterRenders = 0;
     manualStereoMixes = 0;
     manualEchoMixes = 0;
+    culledNodes = 0;
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -34,8 +37,11 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfSilentRenders += otherStats.hrtfSilentRenders;
     hrtfThrottleRenders += otherStats.hrtfThrottleRenders;
+    hrtfClusterMixes += otherStats.hrtfClusterMixes;
+    hrtfClusterRenders += otherStats.hrtfClusterRenders;
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
+    culledNodes += otherStats.culledNodes;
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
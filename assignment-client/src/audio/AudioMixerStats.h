@@ -26,10 +26,14 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfSilentRenders { 0 };
     int hrtfThrottleRenders { 0 };
+    int hrtfClusterMixes { 0 };
+    int hrtfClusterRenders { 0 };
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int culledNodes { 0 };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
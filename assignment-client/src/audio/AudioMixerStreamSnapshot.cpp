@@ -0,0 +1,56 @@
+//
+//  AudioMixerStreamSnapshot.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include "AudioMixerClientData.h"
+#include "InjectedAudioStream.h"
+
+#include "AudioMixerStreamSnapshot.h"
+
+void AudioMixerStreamSnapshot::build(ConstIter begin, ConstIter end) {
+    _nodes.clear();
+    _streams.clear();
+    _streamNodes.clear();
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        Node snapshotNode { node->getUUID(), (int)_streams.size(), 0 };
+
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (nodeData) {
+            nodeData->eachAudioStream([&](const PositionalAudioStream& stream) {
+                float attenuationRatio = 1.0f;
+                if (stream.getType() == PositionalAudioStream::Injector) {
+                    attenuationRatio = static_cast<const InjectedAudioStream&>(stream).getAttenuationRatio();
+                }
+
+                _streams.push_back({
+                    stream.getPosition(),
+                    stream.getOrientation(),
+                    stream.getLastPopOutputLoudness(),
+                    stream.getLastPopOutputTrailingLoudness(),
+                    attenuationRatio,
+                    stream.getLastPopOutput(),
+                    stream.getStreamIdentifier(),
+                    &stream,
+                    stream.getType(),
+                    stream.getConsecutiveNotMixedCount(),
+                    stream.lastPopSucceeded(),
+                    stream.isStereo(),
+                    stream.shouldLoopbackForNode()
+                });
+                _streamNodes.push_back((int)_nodes.size());
+                ++snapshotNode.numStreams;
+            });
+        }
+
+        _nodes.push_back(snapshotNode);
+    });
+}
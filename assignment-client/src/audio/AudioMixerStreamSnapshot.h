@@ -0,0 +1,73 @@
+//
+//  AudioMixerStreamSnapshot.h
+//  assignment-client/src/audio
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerStreamSnapshot_h
+#define hifi_AudioMixerStreamSnapshot_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioRingBuffer.h>
+#include <NodeList.h>
+
+#include "PositionalAudioStream.h"
+
+// Immutable snapshot of all mixable streams for a single mix frame
+//   The snapshot is published by the AudioMixer once frames are popped, and read lock-free by the slaves.
+//   Streams are referenced by raw pointer: they are only added and removed outside of the mix.
+class AudioMixerStreamSnapshot {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Stream {
+        glm::vec3 position;
+        glm::quat orientation;
+        float lastPopOutputLoudness;
+        float lastPopOutputTrailingLoudness;
+        float attenuationRatio; // injectors only, 1.0 otherwise
+        AudioRingBuffer::ConstIterator lastPopOutput;
+        QUuid streamID;
+        const PositionalAudioStream* stream;
+        PositionalAudioStream::Type type;
+        int consecutiveNotMixedCount;
+        bool lastPopSucceeded;
+        bool isStereo;
+        bool shouldLoopback;
+    };
+
+    struct Node {
+        QUuid nodeID;
+        int firstStream;
+        int numStreams;
+    };
+
+    // rebuild the snapshot over the nodes in [begin, end)
+    // nodes are indexed in iteration order, nodes without client data have no streams
+    void build(ConstIter begin, ConstIter end);
+
+    int getNumNodes() const { return (int)_nodes.size(); }
+    const Node& getNode(int index) const { return _nodes[index]; }
+
+    const std::vector<Stream>& getStreams() const { return _streams; }
+    const Stream* streamsBegin(const Node& node) const { return _streams.data() + node.firstStream; }
+    const Stream* streamsEnd(const Node& node) const { return _streams.data() + node.firstStream + node.numStreams; }
+
+    // returns the index of the node owning the stream at streamIndex
+    int getNodeIndex(int streamIndex) const { return _streamNodes[streamIndex]; }
+
+private:
+    std::vector<Node> _nodes;
+    std::vector<Stream> _streams;
+    std::vector<int> _streamNodes;
+};
+
+#endif // hifi_AudioMixerStreamSnapshot_h
@@ -22,6 +22,7 @@
 #include "AvatarMixerClientData.h"
 
 #include "AvatarMixerSlavePool.h"
+#include "AvatarMixerSpatialIndex.h"
 
 /// Handles assignments of type AvatarMixer - distribution of avatar data to various clients
 class AvatarMixer : public ThreadedAssignment {
@@ -112,6 +113,7 @@ private:
 
 
     AvatarMixerSlavePool _slavePool;
+    AvatarMixerSpatialIndex _spatialIndex;
 
 };
 
@@ -62,9 +62,49 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     }
     _lastReceivedSequenceNumber = sequenceNumber;
 
+    invalidateEncodedAvatarData();
+
     // compute the offset to the data payload
     return _avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()));
 }
+
+QByteArray AvatarMixerClientData::getEncodedAvatarData(AvatarData::AvatarDataDetail detail, quint64 lastSentTime,
+                                                       bool dropFaceTracking, const glm::vec3& viewerPosition,
+                                                       bool& wasCached) const {
+    std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+
+    // the encoding only depends on the viewer through the sections it includes,
+    // and the distance-based joint culling (only applied to CullSmallData)
+    AvatarDataPacket::HasFlags hasFlags = _avatar->getHasFlags(detail, lastSentTime, dropFaceTracking);
+    float minRotationDOT = (detail == AvatarData::CullSmallData) ? _avatar->getDistanceBasedMinRotationDOT(viewerPosition) : 0.0f;
+
+    for (const auto& encoded : _encodedAvatarData) {
+        if (encoded.detail == detail && encoded.hasFlags == hasFlags && encoded.minRotationDOT == minRotationDOT) {
+            wasCached = true;
+            return encoded.bytes;
+        }
+    }
+
+    // joints are delta encoded against a keyframe of default joints, rather than per-viewer state
+    if (_keyframeJointData.size() != _avatar->getJointCount()) {
+        _keyframeJointData = QVector<JointData>(_avatar->getJointCount());
+    }
+
+    AvatarDataPacket::HasFlags hasFlagsOut;
+    const bool distanceAdjust = true;
+    QByteArray bytes = _avatar->toByteArray(detail, lastSentTime, _keyframeJointData,
+                                            hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, nullptr);
+
+    _encodedAvatarData.push_back({ detail, hasFlags, minRotationDOT, bytes });
+    wasCached = false;
+    return bytes;
+}
+
+void AvatarMixerClientData::invalidateEncodedAvatarData() {
+    std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+    _encodedAvatarData.clear();
+}
+
 uint64_t AvatarMixerClientData::getLastBroadcastTime(const QUuid& nodeUUID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastTimes.find(nodeUUID);
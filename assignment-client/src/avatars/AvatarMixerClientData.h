@@ -14,9 +14,11 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
+#include <vector>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QUrl>
@@ -41,7 +43,7 @@ public:
     using HRCTime = p_high_resolution_clock::time_point;
 
     int parseData(ReceivedMessage& message) override;
-    AvatarData& getAvatar() { return *_avatar; }
+    AvatarData& getAvatar() { invalidateEncodedAvatarData(); return *_avatar; }
     const AvatarData* getConstAvatarData() const { return _avatar.get(); }
     AvatarSharedPointer getAvatarSharedPointer() const { return _avatar; }
 
@@ -119,10 +121,11 @@ public:
         return result;
     }
 
-    QVector<JointData>& getLastOtherAvatarSentJoints(QUuid otherAvatar) {
-        _lastOtherAvatarSentJoints[otherAvatar].resize(_avatar->getJointCount());
-        return _lastOtherAvatarSentJoints[otherAvatar];
-    }
+    // returns this avatar's data encoded by toByteArray for a viewer that was last sent it at lastSentTime
+    // encodings are shared by all viewers needing the same sections, and cached until the avatar changes
+    // wasCached is set to false if the avatar had to be encoded
+    QByteArray getEncodedAvatarData(AvatarData::AvatarDataDetail detail, quint64 lastSentTime, bool dropFaceTracking,
+                                    const glm::vec3& viewerPosition, bool& wasCached) const;
 
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(); // returns number of packets processed
@@ -142,7 +145,21 @@ private:
     // this is a map of the last time we encoded an "other" avatar for
     // sending to "this" node
     std::unordered_map<QUuid, quint64> _lastOtherAvatarEncodeTime;
-    std::unordered_map<QUuid, QVector<JointData>> _lastOtherAvatarSentJoints;
+
+    void invalidateEncodedAvatarData();
+
+    // encodings of this avatar, shared by all viewers (see getEncodedAvatarData)
+    struct EncodedAvatarData {
+        AvatarData::AvatarDataDetail detail;
+        AvatarDataPacket::HasFlags hasFlags;
+        float minRotationDOT;
+        QByteArray bytes;
+    };
+    mutable std::mutex _encodedAvatarDataMutex;
+    mutable std::vector<EncodedAvatarData> _encodedAvatarData;
+
+    // the joint baseline that joints are encoded against, shared by all viewers
+    mutable QVector<JointData> _keyframeJointData;
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ false };
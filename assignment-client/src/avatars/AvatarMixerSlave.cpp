@@ -31,6 +31,7 @@
 #include "AvatarMixer.h"
 #include "AvatarMixerClientData.h"
 #include "AvatarMixerSlave.h"
+#include "AvatarMixerSpatialIndex.h"
 
 
 void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
@@ -40,12 +41,14 @@ void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
 
 void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end, 
                                 p_high_resolution_clock::time_point lastFrameTimestamp,
-                                float maxKbpsPerNode, float throttlingRatio) {
+                                float maxKbpsPerNode, float throttlingRatio,
+                                const AvatarMixerSpatialIndex* spatialIndex) {
     _begin = begin;
     _end = end;
     _lastFrameTimestamp = lastFrameTimestamp;
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
+    _spatialIndex = spatialIndex;
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
@@ -95,7 +98,7 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
         nodeData->resetInViewStats();
 
-        const AvatarData& avatar = nodeData->getAvatar();
+        const AvatarData& avatar = *nodeData->getConstAvatarData();
         glm::vec3 myPosition = avatar.getClientGlobalPosition();
 
         // reset the internal state for correct random number distribution
@@ -141,166 +144,135 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
         // setup a PacketList for the avatarPackets
         auto avatarPacketList = NLPacketList::create(PacketType::BulkAvatarData);
 
-        // Define the minimum bubble size
-        static const glm::vec3 minBubbleSize = glm::vec3(0.3f, 1.3f, 0.3f);
-        // Define the scale of the box for the current node
-        glm::vec3 nodeBoxScale = (nodeData->getPosition() - nodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-        // Set up the bounding box for the current node
-        AABox nodeBox(nodeData->getGlobalBoundingBoxCorner(), nodeBoxScale);
-        // Clamp the size of the bounding box to a minimum scale
-        if (glm::any(glm::lessThan(nodeBoxScale, minBubbleSize))) {
-            nodeBox.setScaleStayCentered(minBubbleSize);
-        }
-        // Quadruple the scale of both bounding boxes
-        nodeBox.embiggen(4.0f);
+        // Set up the bubble box for the current node
+        AABox nodeBox = AvatarMixerSpatialIndex::computeBubbleBox(*nodeData);
 
+        // only the avatars indexed near our bubble can be touching it
+        int numAvatars = _spatialIndex->getNumAvatars();
+        _spatialIndex->findBubbleCandidates(nodeBox, _bubbleCandidates);
+        _isBubbleCandidate.assign(numAvatars, false);
+        for (int avatarIndex : _bubbleCandidates) {
+            _isBubbleCandidate[avatarIndex] = true;
+        }
 
-        // setup list of AvatarData as well as maps to map betweeen the AvatarData and the original nodes
-        // for calling the AvatarData::sortAvatars() function and getting our sorted list of client nodes
-        QList<AvatarSharedPointer> avatarList;
-        std::unordered_map<AvatarSharedPointer, SharedNodePointer> avatarDataToNodes;
+        auto shouldIgnore = [&](int avatarIndex)->bool {
+            const auto& indexedAvatar = _spatialIndex->getAvatar(avatarIndex);
+            const SharedNodePointer& avatarNode = indexedAvatar.node;
+            const AvatarMixerClientData* avatarNodeData = indexedAvatar.data;
+
+            bool shouldIgnore = false;
+
+            // We will also ignore other nodes for a couple of different reasons:
+            //   1) ignore bubbles and ignore specific node
+            //   2) the node hasn't really updated it's frame data recently, this can
+            //      happen if for example the avatar is connected on a desktop and sending
+            //      updates at ~30hz. So every 3 frames we skip a frame.
+            quint64 startIgnoreCalculation = usecTimestampNow();
+
+            // make sure we have data for this avatar, that it isn't the same node,
+            // and isn't an avatar that the viewing node has ignored
+            // or that has ignored the viewing node
+            if (avatarNode->getUUID() == node->getUUID()
+                || (node->isIgnoringNodeWithID(avatarNode->getUUID()) && !PALIsOpen)
+                || (avatarNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
+                shouldIgnore = true;
+            } else {
 
-        std::for_each(_begin, _end, [&](const SharedNodePointer& otherNode) {
-            const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(otherNode->getLinkedData());
+                // Check to see if the space bubble is enabled
+                // Don't bother with these checks if the other avatar has their bubble enabled and we're gettingAnyIgnored
+                if (node->isIgnoreRadiusEnabled() || (avatarNode->isIgnoreRadiusEnabled() && !getsAnyIgnored)) {
 
-            // theoretically it's possible for a Node to be in the NodeList (and therefore end up here),
-            // but not have yet sent data that's linked to the node. Check for that case and don't
-            // consider those nodes.
-            if (otherNodeData) {
-                AvatarSharedPointer otherAvatar = otherNodeData->getAvatarSharedPointer();
-                avatarList << otherAvatar;
-                avatarDataToNodes[otherAvatar] = otherNode;
+                    // Perform the collision check between the two bounding boxes
+                    if (_isBubbleCandidate[avatarIndex] && nodeBox.touches(indexedAvatar.bubbleBox)) {
+                        nodeData->ignoreOther(node, avatarNode);
+                        shouldIgnore = !getsAnyIgnored;
+                    }
+                }
+                // Not close enough to ignore
+                if (!shouldIgnore) {
+                    nodeData->removeFromRadiusIgnoringSet(node, avatarNode->getUUID());
+                }
             }
-        });
-
-        AvatarSharedPointer thisAvatar = nodeData->getAvatarSharedPointer();
-        ViewFrustum cameraView = nodeData->getViewFrustom();
-        std::priority_queue<AvatarPriority> sortedAvatars;
-        AvatarData::sortAvatars(avatarList, cameraView, sortedAvatars,
-
-                [&](AvatarSharedPointer avatar)->uint64_t{
-                    auto avatarNode = avatarDataToNodes[avatar];
-                    assert(avatarNode); // we can't have gotten here without the avatarData being a valid key in the map
-                    return nodeData->getLastBroadcastTime(avatarNode->getUUID());
-                },
-
-                [&](AvatarSharedPointer avatar)->float{
-                    glm::vec3 nodeBoxHalfScale = (avatar->getPosition() - avatar->getGlobalBoundingBoxCorner());
-                    return glm::max(nodeBoxHalfScale.x, glm::max(nodeBoxHalfScale.y, nodeBoxHalfScale.z));
-                },
-
-                [&](AvatarSharedPointer avatar)->bool{
-                    if (avatar == thisAvatar) {
-                        return true; // ignore ourselves...
+            quint64 endIgnoreCalculation = usecTimestampNow();
+            _stats.ignoreCalculationElapsedTime += (endIgnoreCalculation - startIgnoreCalculation);
+
+            if (!shouldIgnore) {
+                AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(avatarNode->getUUID());
+                AvatarDataSequenceNumber lastSeqFromSender = avatarNodeData->getLastReceivedSequenceNumber();
+
+                // FIXME - This code does appear to be working. But it seems brittle.
+                //         It supports determining if the frame of data for this "other"
+                //         avatar has already been sent to the reciever. This has been
+                //         verified to work on a desktop display that renders at 60hz and
+                //         therefore sends to mixer at 30hz. Each second you'd expect to
+                //         have 15 (45hz-30hz) duplicate frames. In this case, the stat
+                //         avg_other_av_skips_per_second does report 15.
+                //
+                // make sure we haven't already sent this data from this sender to this receiver
+                // or that somehow we haven't sent
+                if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
+                    // don't ignore this avatar if we haven't sent any update for a long while
+                    // in an effort to prevent other interfaces from deleting a stale avatar instance
+                    uint64_t lastBroadcastTime = nodeData->getLastBroadcastTime(avatarNode->getUUID());
+                    const uint64_t AVATAR_UPDATE_STALE = AVATAR_UPDATE_TIMEOUT - USECS_PER_SECOND;
+                    if (lastBroadcastTime > avatarNodeData->getIdentityChangeTimestamp() &&
+                            lastBroadcastTime + AVATAR_UPDATE_STALE > startIgnoreCalculation) {
+                        ++numAvatarsHeldBack;
+                        shouldIgnore = true;
                     }
+                } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
+                    // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
+                    ++numAvatarsWithSkippedFrames;
+                }
+            }
+            return shouldIgnore;
+        };
 
-                    bool shouldIgnore = false;
-
-                    // We will also ignore other nodes for a couple of different reasons:
-                    //   1) ignore bubbles and ignore specific node
-                    //   2) the node hasn't really updated it's frame data recently, this can
-                    //      happen if for example the avatar is connected on a desktop and sending
-                    //      updates at ~30hz. So every 3 frames we skip a frame.
-                    auto avatarNode = avatarDataToNodes[avatar];
-
-                    assert(avatarNode); // we can't have gotten here without the avatarData being a valid key in the map
+        // prioritize the avatars we aren't ignoring
+        ViewFrustum cameraView = nodeData->getViewFrustom();
+        uint64_t now = usecTimestampNow();
+        _sortedAvatars.clear();
+        for (int avatarIndex = 0; avatarIndex < numAvatars; ++avatarIndex) {
+            if (shouldIgnore(avatarIndex)) {
+                continue;
+            }
 
-                    const AvatarMixerClientData* avatarNodeData = reinterpret_cast<const AvatarMixerClientData*>(avatarNode->getLinkedData());
-                    assert(avatarNodeData); // we can't have gotten here without avatarNode having valid data
-                    quint64 startIgnoreCalculation = usecTimestampNow();
+            const auto& indexedAvatar = _spatialIndex->getAvatar(avatarIndex);
+            uint64_t lastUpdated = nodeData->getLastBroadcastTime(indexedAvatar.node->getUUID());
+            float priority = AvatarData::computeSortPriority(cameraView, indexedAvatar.position,
+                                                             indexedAvatar.boundingRadius, lastUpdated, now);
+            _sortedAvatars.push_back(std::make_pair(priority, avatarIndex));
+        }
 
-                    // make sure we have data for this avatar, that it isn't the same node,
-                    // and isn't an avatar that the viewing node has ignored
-                    // or that has ignored the viewing node
-                    if (!avatarNode->getLinkedData()
-                        || avatarNode->getUUID() == node->getUUID()
-                        || (node->isIgnoringNodeWithID(avatarNode->getUUID()) && !PALIsOpen)
-                        || (avatarNode->isIgnoringNodeWithID(node->getUUID()) && !getsAnyIgnored)) {
-                        shouldIgnore = true;
-                    } else {
-
-                        // Check to see if the space bubble is enabled
-                        // Don't bother with these checks if the other avatar has their bubble enabled and we're gettingAnyIgnored
-                        if (node->isIgnoreRadiusEnabled() || (avatarNode->isIgnoreRadiusEnabled() && !getsAnyIgnored)) {
-
-                            // Define the scale of the box for the current other node
-                            glm::vec3 otherNodeBoxScale = (avatarNodeData->getPosition() - avatarNodeData->getGlobalBoundingBoxCorner()) * 2.0f;
-                            // Set up the bounding box for the current other node
-                            AABox otherNodeBox(avatarNodeData->getGlobalBoundingBoxCorner(), otherNodeBoxScale);
-                            // Clamp the size of the bounding box to a minimum scale
-                            if (glm::any(glm::lessThan(otherNodeBoxScale, minBubbleSize))) {
-                                otherNodeBox.setScaleStayCentered(minBubbleSize);
-                            }
-                            // Quadruple the scale of both bounding boxes
-                            otherNodeBox.embiggen(4.0f);
-
-                            // Perform the collision check between the two bounding boxes
-                            if (nodeBox.touches(otherNodeBox)) {
-                                nodeData->ignoreOther(node, avatarNode);
-                                shouldIgnore = !getsAnyIgnored;
-                            }
-                        }
-                        // Not close enough to ignore
-                        if (!shouldIgnore) {
-                            nodeData->removeFromRadiusIgnoringSet(node, avatarNode->getUUID());
-                        }
-                    }
-                    quint64 endIgnoreCalculation = usecTimestampNow();
-                    _stats.ignoreCalculationElapsedTime += (endIgnoreCalculation - startIgnoreCalculation);
-
-                    if (!shouldIgnore) {
-                        AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(avatarNode->getUUID());
-                        AvatarDataSequenceNumber lastSeqFromSender = avatarNodeData->getLastReceivedSequenceNumber();
-
-                        // FIXME - This code does appear to be working. But it seems brittle.
-                        //         It supports determining if the frame of data for this "other"
-                        //         avatar has already been sent to the reciever. This has been
-                        //         verified to work on a desktop display that renders at 60hz and
-                        //         therefore sends to mixer at 30hz. Each second you'd expect to
-                        //         have 15 (45hz-30hz) duplicate frames. In this case, the stat
-                        //         avg_other_av_skips_per_second does report 15.
-                        //
-                        // make sure we haven't already sent this data from this sender to this receiver
-                        // or that somehow we haven't sent
-                        if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                            // don't ignore this avatar if we haven't sent any update for a long while
-                            // in an effort to prevent other interfaces from deleting a stale avatar instance
-                            uint64_t lastBroadcastTime = nodeData->getLastBroadcastTime(avatarNode->getUUID());
-                            const AvatarMixerClientData* otherNodeData = reinterpret_cast<const AvatarMixerClientData*>(avatarNode->getLinkedData());
-                            const uint64_t AVATAR_UPDATE_STALE = AVATAR_UPDATE_TIMEOUT - USECS_PER_SECOND;
-                            if (lastBroadcastTime > otherNodeData->getIdentityChangeTimestamp() &&
-                                    lastBroadcastTime + AVATAR_UPDATE_STALE > startIgnoreCalculation) {
-                                ++numAvatarsHeldBack;
-                                shouldIgnore = true;
-                            }
-                        } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
-                            // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
-                            ++numAvatarsWithSkippedFrames;
-                        }
-                    }
-                    return shouldIgnore;
-                });
+        // the avatars are only sorted while we are within budget (a partial heap sort):
+        // once over budget we stay over budget, and the remaining avatars all get the same minimal data in any order
+        std::make_heap(_sortedAvatars.begin(), _sortedAvatars.end());
+        auto sortedEnd = _sortedAvatars.end();
 
         // loop through our sorted avatars and allocate our bandwidth to them accordingly
         int avatarRank = 0;
 
         // this is overly conservative, because it includes some avatars we might not consider
-        int remainingAvatars = (int)sortedAvatars.size(); 
+        int remainingAvatars = (int)_sortedAvatars.size(); 
 
-        while (!sortedAvatars.empty()) {
-            AvatarPriority sortData = sortedAvatars.top();
-            sortedAvatars.pop();
-            const auto& avatarData = sortData.avatar;
+        while (remainingAvatars > 0) {
             avatarRank++;
             remainingAvatars--;
 
-            auto otherNode = avatarDataToNodes[avatarData];
-            assert(otherNode); // we can't have gotten here without the avatarData being a valid key in the map
-
             // NOTE: Here's where we determine if we are over budget and drop to bare minimum data
             int minimRemainingAvatarBytes = minimumBytesPerAvatar * remainingAvatars;
             bool overBudget = (identityBytesSent + numAvatarDataBytes + minimRemainingAvatarBytes) > maxAvatarBytesPerFrame;
 
+            if (!overBudget) {
+                // move the highest priority avatar to the back of the heap
+                std::pop_heap(_sortedAvatars.begin(), sortedEnd);
+            }
+            // take the back of the heap (the heap remains valid without it)
+            --sortedEnd;
+            int avatarIndex = sortedEnd->second;
+
+            const SharedNodePointer& otherNode = _spatialIndex->getAvatar(avatarIndex).node;
+
             quint64 startAvatarDataPacking = usecTimestampNow();
 
             ++numOtherAvatars;
@@ -341,30 +313,32 @@ void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
 
             bool includeThisAvatar = true;
             auto lastEncodeForOther = nodeData->getLastOtherAvatarEncodeTime(otherNode->getUUID());
-            QVector<JointData>& lastSentJointsForOther = nodeData->getLastOtherAvatarSentJoints(otherNode->getUUID());
-            bool distanceAdjust = true;
             glm::vec3 viewerPosition = myPosition;
-            AvatarDataPacket::HasFlags hasFlagsOut; // the result of the toByteArray
             bool dropFaceTracking = false;
+            bool wasCached = false;
 
+            // the other avatar is encoded once for all the viewers that need the same data
             quint64 start = usecTimestampNow();
-            QByteArray bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther, 
-                                            hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+            QByteArray bytes = otherNodeData->getEncodedAvatarData(detail, lastEncodeForOther, dropFaceTracking,
+                                                                   viewerPosition, wasCached);
             quint64 end = usecTimestampNow();
             _stats.toByteArrayElapsedTime += (end - start);
+            if (wasCached) {
+                _stats.numEncodesShared++;
+            }
 
             static const int MAX_ALLOWED_AVATAR_DATA = (1400 - NUM_BYTES_RFC4122_UUID);
             if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
                 qCWarning(avatars) << "otherAvatar.toByteArray() resulted in very large buffer:" << bytes.size() << "... attempt to drop facial data";
 
                 dropFaceTracking = true; // first try dropping the facial data
-                bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                bytes = otherNodeData->getEncodedAvatarData(detail, lastEncodeForOther, dropFaceTracking,
+                                                            viewerPosition, wasCached);
 
                 if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
                     qCWarning(avatars) << "otherAvatar.toByteArray() without facial data resulted in very large buffer:" << bytes.size() << "... reduce to MinimumData";
-                    bytes = otherAvatar->toByteArray(AvatarData::MinimumData, lastEncodeForOther, lastSentJointsForOther,
-                        hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                    bytes = otherNodeData->getEncodedAvatarData(AvatarData::MinimumData, lastEncodeForOther, dropFaceTracking,
+                                                                viewerPosition, wasCached);
                 }
 
                 if (bytes.size() > MAX_ALLOWED_AVATAR_DATA) {
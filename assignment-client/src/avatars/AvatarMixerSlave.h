@@ -12,7 +12,10 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <vector>
+
 class AvatarMixerClientData;
+class AvatarMixerSpatialIndex;
 
 class AvatarMixerSlaveStats {
 public:
@@ -26,6 +29,7 @@ public:
     int numIdentityPackets { 0 };
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
+    int numEncodesShared { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -46,6 +50,7 @@ public:
         numIdentityPackets = 0;
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
+        numEncodesShared = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -65,6 +70,7 @@ public:
         numIdentityPackets += rhs.numIdentityPackets;
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
+        numEncodesShared += rhs.numEncodesShared;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -83,7 +89,8 @@ public:
     void configure(ConstIter begin, ConstIter end);
     void configureBroadcast(ConstIter begin, ConstIter end, 
                     p_high_resolution_clock::time_point lastFrameTimestamp, 
-                    float maxKbpsPerNode, float throttlingRatio);
+                    float maxKbpsPerNode, float throttlingRatio,
+                    const AvatarMixerSpatialIndex* spatialIndex);
 
     void processIncomingPackets(const SharedNodePointer& node);
     void broadcastAvatarData(const SharedNodePointer& node);
@@ -100,6 +107,12 @@ private:
     p_high_resolution_clock::time_point _lastFrameTimestamp;
     float _maxKbpsPerNode { 0.0f };
     float _throttlingRatio { 0.0f };
+    const AvatarMixerSpatialIndex* _spatialIndex { nullptr };
+
+    // per-viewer state (reused across viewers)
+    std::vector<int> _bubbleCandidates;
+    std::vector<bool> _isBubbleCandidate;
+    std::vector<std::pair<float, int>> _sortedAvatars;
 
     AvatarMixerSlaveStats _stats;
 };
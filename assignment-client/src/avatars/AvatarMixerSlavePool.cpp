@@ -77,10 +77,11 @@ void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
                                      p_high_resolution_clock::time_point lastFrameTimestamp, 
-                                     float maxKbpsPerNode, float throttlingRatio) {
+                                     float maxKbpsPerNode, float throttlingRatio,
+                                     const AvatarMixerSpatialIndex* spatialIndex) {
     _function = &AvatarMixerSlave::broadcastAvatarData;
     _configure = [&](AvatarMixerSlave& slave) { 
-        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio);
+        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio, spatialIndex);
    };
     run(begin, end);
 }
@@ -0,0 +1,113 @@
+//
+//  AvatarMixerSpatialIndex.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include "AvatarMixerClientData.h"
+#include "AvatarMixerSpatialIndex.h"
+
+// minimum size of an avatar's bubble box, before it is embiggened
+static const glm::vec3 MIN_BUBBLE_SIZE = glm::vec3(0.3f, 1.3f, 0.3f);
+
+// the bubble box is a multiple of the avatar's bounding box
+static const float BUBBLE_SCALE = 4.0f;
+
+// cell coordinates are packed into 21 bits per axis
+static const int CELL_BITS = 21;
+static const int CELL_OFFSET = 1 << (CELL_BITS - 1);
+static const int CELL_MAX = (1 << CELL_BITS) - 1;
+
+AABox AvatarMixerSpatialIndex::computeBubbleBox(const AvatarMixerClientData& data) {
+    // Define the scale of the box for the node
+    glm::vec3 boxScale = (data.getPosition() - data.getGlobalBoundingBoxCorner()) * 2.0f;
+    // Set up the bounding box for the node
+    AABox box(data.getGlobalBoundingBoxCorner(), boxScale);
+    // Clamp the size of the bounding box to a minimum scale
+    if (glm::any(glm::lessThan(boxScale, MIN_BUBBLE_SIZE))) {
+        box.setScaleStayCentered(MIN_BUBBLE_SIZE);
+    }
+    // Quadruple the scale of the bounding box
+    box.embiggen(BUBBLE_SCALE);
+    return box;
+}
+
+void AvatarMixerSpatialIndex::build(ConstIter begin, ConstIter end) {
+    _avatars.clear();
+    _entries.clear();
+
+    float maxBubbleSize = 0.0f;
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        const AvatarMixerClientData* data = reinterpret_cast<const AvatarMixerClientData*>(node->getLinkedData());
+
+        // theoretically it's possible for a Node to be in the NodeList (and therefore end up here),
+        // but not have yet sent data that's linked to the node. Check for that case and don't
+        // consider those nodes.
+        if (!data) {
+            return;
+        }
+
+        glm::vec3 position = data->getConstAvatarData()->getPosition();
+        glm::vec3 halfScale = position - data->getGlobalBoundingBoxCorner();
+        float boundingRadius = glm::max(halfScale.x, glm::max(halfScale.y, halfScale.z));
+
+        AABox bubbleBox = computeBubbleBox(*data);
+        glm::vec3 bubbleScale = bubbleBox.getScale();
+        maxBubbleSize = glm::max(maxBubbleSize, glm::max(bubbleScale.x, glm::max(bubbleScale.y, bubbleScale.z)));
+
+        _avatars.push_back({ node, data, position, boundingRadius, bubbleBox });
+    });
+
+    // with cells as large as the largest bubble box, the center of any box touching a given box
+    // lies within half a cell of it
+    _cellSize = glm::max(maxBubbleSize, EPSILON);
+
+    for (int i = 0; i < (int)_avatars.size(); ++i) {
+        _entries.push_back({ keyForCell(cellForPosition(_avatars[i].bubbleBox.calcCenter())), i });
+    }
+
+    // stable, so that entries of a cell stay in avatar order
+    std::stable_sort(_entries.begin(), _entries.end());
+}
+
+void AvatarMixerSpatialIndex::findBubbleCandidates(const AABox& box, std::vector<int>& avatars) const {
+    avatars.clear();
+
+    const glm::vec3 halfCell = glm::vec3(0.5f * _cellSize);
+    const glm::ivec3 minCell = cellForPosition(box.getMinimumPoint() - halfCell);
+    const glm::ivec3 maxCell = cellForPosition(box.getMaximumPoint() + halfCell);
+
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
+                Entry key { keyForCell(glm::ivec3(x, y, z)), 0 };
+
+                auto range = std::equal_range(_entries.cbegin(), _entries.cend(), key);
+                for (auto it = range.first; it != range.second; ++it) {
+                    avatars.push_back(it->avatar);
+                }
+            }
+        }
+    }
+
+    // clamped cells may be visited more than once
+    std::sort(avatars.begin(), avatars.end());
+    avatars.erase(std::unique(avatars.begin(), avatars.end()), avatars.end());
+}
+
+glm::ivec3 AvatarMixerSpatialIndex::cellForPosition(const glm::vec3& position) const {
+    return glm::ivec3(glm::floor(position / _cellSize));
+}
+
+AvatarMixerSpatialIndex::CellKey AvatarMixerSpatialIndex::keyForCell(const glm::ivec3& cell) {
+    // clamping is monotonic, so neighboring cells remain neighbors (boxes are still checked by the caller)
+    glm::ivec3 offset = glm::clamp(cell + glm::ivec3(CELL_OFFSET), glm::ivec3(0), glm::ivec3(CELL_MAX));
+    return ((CellKey)offset.x << (2 * CELL_BITS)) | ((CellKey)offset.y << CELL_BITS) | (CellKey)offset.z;
+}
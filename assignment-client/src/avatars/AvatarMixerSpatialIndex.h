@@ -0,0 +1,71 @@
+//
+//  AvatarMixerSpatialIndex.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarMixerSpatialIndex_h
+#define hifi_AvatarMixerSpatialIndex_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <NodeList.h>
+
+class AvatarMixerClientData;
+
+// Index of the avatars of a single broadcast frame
+//   The index holds what every viewer needs about the other avatars (computed once per frame, not once per pair),
+//   and a uniform grid of the avatars' bubble boxes, so a viewer only tests the bubbles around its own.
+//   It is built by the AvatarMixer before broadcasting, and is read-only (thread-safe) while the slaves broadcast.
+class AvatarMixerSpatialIndex {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Avatar {
+        SharedNodePointer node;
+        const AvatarMixerClientData* data;
+        glm::vec3 position;
+        float boundingRadius;
+        AABox bubbleBox;
+    };
+
+    // returns the box used to check if an avatar is inside the ignore bubble of another
+    static AABox computeBubbleBox(const AvatarMixerClientData& data);
+
+    // rebuild the index over the nodes in [begin, end), skipping nodes without avatar data
+    void build(ConstIter begin, ConstIter end);
+
+    int getNumAvatars() const { return (int)_avatars.size(); }
+    const Avatar& getAvatar(int index) const { return _avatars[index]; }
+
+    // fills avatars with the indices (in order) of the avatars whose bubble box may touch box
+    // box must not be larger than the largest bubble box in the index
+    void findBubbleCandidates(const AABox& box, std::vector<int>& avatars) const;
+
+private:
+    using CellKey = uint64_t;
+
+    struct Entry {
+        CellKey cell;
+        int avatar;
+
+        bool operator<(const Entry& other) const { return cell < other.cell; }
+    };
+
+    glm::ivec3 cellForPosition(const glm::vec3& position) const;
+    static CellKey keyForCell(const glm::ivec3& cell);
+
+    std::vector<Avatar> _avatars;
+
+    std::vector<Entry> _entries; // sorted by cell
+    float _cellSize { 1.0f };
+};
+
+#endif // hifi_AvatarMixerSpatialIndex_h
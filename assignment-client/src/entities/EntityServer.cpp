@@ -85,6 +85,7 @@ OctreeServer::UniqueSendThread EntityServer::newSendThread(const SharedNodePoint
 void EntityServer::beforeRun() {
     _pruneDeletedEntitiesTimer = new QTimer();
     connect(_pruneDeletedEntitiesTimer, SIGNAL(timeout()), this, SLOT(pruneDeletedEntities()));
+    connect(_pruneDeletedEntitiesTimer, SIGNAL(timeout()), this, SLOT(pruneChangedEntities()));
     const int PRUNE_DELETED_MODELS_INTERVAL_MSECS = 1 * 1000; // once every second
     _pruneDeletedEntitiesTimer->start(PRUNE_DELETED_MODELS_INTERVAL_MSECS);
 }
@@ -272,6 +273,23 @@ void EntityServer::pruneDeletedEntities() {
     }
 }
 
+void EntityServer::pruneChangedEntities() {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+
+    // keep the changes that some node has yet to be sent, but not too many of them, nodes that are further behind
+    // will traverse the tree for their next scene
+    const quint64 MAX_CHANGED_ENTITIES_AGE_USECS = 10 * USECS_PER_SECOND;
+    quint64 earliestLastTimeBagEmpty = usecTimestampNow();
+    quint64 oldestChangeToKeep = earliestLastTimeBagEmpty - MAX_CHANGED_ENTITIES_AGE_USECS;
+    DependencyManager::get<NodeList>()->eachNode([&earliestLastTimeBagEmpty](const SharedNodePointer& node) {
+        if (node->getLinkedData()) {
+            EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
+            earliestLastTimeBagEmpty = std::min(earliestLastTimeBagEmpty, nodeData->getLastTimeBagEmpty());
+        }
+    });
+    tree->forgetEntitiesChangedBefore(std::max(earliestLastTimeBagEmpty, oldestChangeToKeep));
+}
+
 void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectionObject) {
     bool wantEditLogging = false;
     readOptionBool(QString("wantEditLogging"), settingsSectionObject, wantEditLogging);
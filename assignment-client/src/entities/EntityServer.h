@@ -63,6 +63,7 @@ public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
     void pruneDeletedEntities();
+    void pruneChangedEntities();
     void entityFilterAdded(EntityItemID id, bool success);
 
 protected:
@@ -80,6 +80,17 @@ void EntityTreeSendThread::preDistributionProcessing() {
     }
 }
 
+bool EntityTreeSendThread::addChangedElementsToBag(OctreeQueryNode* nodeData) {
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+
+    // the server's journal of changed entities leads straight to their elements
+    bool success = false;
+    entityTree->withReadLock([&]{
+        success = entityTree->addElementsChangedSinceToBag(nodeData->getLastTimeBagEmpty(), nodeData->elementBag);
+    });
+    return success;
+}
+
 bool EntityTreeSendThread::addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID,
                                                               EntityItem& entityItem, EntityNodeData& nodeData) {
     // check if this entity has a parent that is also an entity
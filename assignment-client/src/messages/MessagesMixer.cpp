@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
@@ -29,41 +31,64 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
     packetReceiver.registerListener(PacketType::MessagesUnsubscribe, this, "handleMessagesUnsubscribe");
 }
 
+static void removeSubscriber(std::vector<SharedNodePointer>& subscribers, const SharedNodePointer& node) {
+    auto it = std::find(subscribers.begin(), subscribers.end(), node);
+    if (it != subscribers.end()) {
+        // subscribers are not ordered, swap with the last one
+        *it = subscribers.back();
+        subscribers.pop_back();
+    }
+}
+
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto it = _channelSubscribers.begin();
+    while (it != _channelSubscribers.end()) {
+        removeSubscriber(it.value(), killedNode);
+        if (it.value().empty()) {
+            it = _channelSubscribers.erase(it);
+        } else {
+            ++it;
+        }
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    QString channel = MessagesClient::decodeMessagesChannel(receivedMessage);
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto it = _channelSubscribers.constFind(channel);
+    if (it == _channelSubscribers.constEnd()) {
+        return;
+    }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    // subscribers get the message exactly as it was sent, so it is forwarded without decoding and re-encoding it
+    QByteArray payload = receivedMessage->getMessage();
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (const auto& node : it.value()) {
+        if (node->getActiveSocket()) {
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(payload);
+            nodeList->sendPacketList(std::move(packetList), *node);
+        }
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    auto& subscribers = _channelSubscribers[channel];
+    if (std::find(subscribers.begin(), subscribers.end(), senderNode) == subscribers.end()) {
+        subscribers.push_back(senderNode);
+    }
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    auto it = _channelSubscribers.find(channel);
+    if (it != _channelSubscribers.end()) {
+        removeSubscriber(it.value(), senderNode);
+        if (it.value().empty()) {
+            _channelSubscribers.erase(it);
+        }
     }
 }
 
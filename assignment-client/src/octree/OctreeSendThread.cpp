@@ -335,6 +335,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     }
 
     bool somethingToSend = true; // assume we have something
+    bool isChangesOnlyScene = false;
 
     // If our packet already has content in it, then we must use the color choice of the waiting packet.
     // If we're starting a fresh packet, then...
@@ -397,13 +398,16 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
             if (nodeData->elementBag.isEmpty()) {
                 nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
             }
+        } else if (!viewFrustumChanged && !isFullScene && addChangedElementsToBag(nodeData)) {
+            // only what changed since the last pass needs to be sent, and may be nothing at all
+            isChangesOnlyScene = true;
         } else {
             nodeData->elementBag.insert(_myServer->getOctree()->getRoot());
         }
     }
 
     // If we have something in our elementBag, then turn them into packets and send them out...
-    if (!nodeData->elementBag.isEmpty()) {
+    if (!nodeData->elementBag.isEmpty() || isChangesOnlyScene) {
         int bytesWritten = 0;
         quint64 start = usecTimestampNow();
 
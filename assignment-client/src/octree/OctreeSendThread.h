@@ -54,6 +54,10 @@ protected:
     /// Called before a packetDistributor pass to allow for pre-distribution processing
     virtual void preDistributionProcessing() {};
 
+    /// Called at the start of a pass when the view hasn't changed, to fill the bag with only the elements that may have
+    /// changed since the last pass. Returns false if the whole tree should be traversed from the root instead.
+    virtual bool addChangedElementsToBag(OctreeQueryNode* nodeData) { return false; }
+
     OctreeServer* _myServer { nullptr };
     QWeakPointer<Node> _node;
 
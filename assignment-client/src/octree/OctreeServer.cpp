@@ -1059,7 +1059,8 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistFilePath=" << _persistFilePath;
 
-        _persistAsFileType = "json.gz";
+        // entities are persisted as gzipped JSON unless the binary format is asked for
+        _persistAsFileType = _persistFilePath.endsWith(".bin", Qt::CaseInsensitive) ? "bin" : "json.gz";
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         readOptionInt(QString("persistInterval"), settingsSectionObject, _persistInterval);
@@ -1181,13 +1182,13 @@ void OctreeServer::domainSettingsRequestComplete() {
             persistAbsoluteFilePath = QDir(PathUtils::getAppDataFilePath("entities/")).absoluteFilePath(_persistFilePath);
         }
 
-        static const QString ENTITY_PERSIST_EXTENSION = ".json.gz";
+        const QString ENTITY_PERSIST_EXTENSION = "." + _persistAsFileType;
 
-        // force the persist file to end with .json.gz
+        // force the persist file to end with .json.gz or .bin
         if (!persistAbsoluteFilePath.endsWith(ENTITY_PERSIST_EXTENSION, Qt::CaseInsensitive)) {
             persistAbsoluteFilePath += ENTITY_PERSIST_EXTENSION;
         } else {
-            // make sure the casing of .json.gz is correct
+            // make sure the casing of the extension is correct
             persistAbsoluteFilePath.replace(ENTITY_PERSIST_EXTENSION, ENTITY_PERSIST_EXTENSION, Qt::CaseInsensitive);
         }
 
@@ -1212,7 +1213,7 @@ void OctreeServer::domainSettingsRequestComplete() {
             if (QFile::exists(oldPersistPath)) {
                 shouldCopy = true;
                 pathToCopyFrom = oldPersistPath;
-            } else if (QFile::exists(oldDefaultPersistPath)) {
+            } else if (_persistAsFileType == "json.gz" && QFile::exists(oldDefaultPersistPath)) {
                 shouldCopy = true;
                 pathToCopyFrom = oldDefaultPersistPath;
             }
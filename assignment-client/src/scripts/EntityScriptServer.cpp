@@ -88,6 +88,12 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     timer->setInterval(LOG_INTERVAL);
     connect(timer, &QTimer::timeout, this, &EntityScriptServer::pushLogs);
     timer->start();
+
+    static const int REBALANCE_INTERVAL = 5 * MSECS_PER_SECOND;
+    auto rebalanceTimer = new QTimer(this);
+    rebalanceTimer->setInterval(REBALANCE_INTERVAL);
+    connect(rebalanceTimer, &QTimer::timeout, this, &EntityScriptServer::rebalanceEntityScripts);
+    rebalanceTimer->start();
 }
 
 EntityScriptServer::~EntityScriptServer() {
@@ -102,9 +108,10 @@ void EntityScriptServer::handleReloadEntityServerScriptPacket(QSharedPointer<Rec
     if (senderNode->getCanRez() || senderNode->getCanRezTmp()) {
         auto entityID = QUuid::fromRfc4122(message->read(NUM_BYTES_RFC4122_UUID));
 
-        if (_entityViewer.getTree() && !_shuttingDown) {
+        auto engine = _entityScriptShards.getEngine(entityID);
+        if (_entityViewer.getTree() && !_shuttingDown && engine) {
             qCDebug(entity_script_server) << "Reloading: " << entityID;
-            _entitiesScriptEngine->unloadEntityScript(entityID);
+            engine->unloadEntityScript(entityID);
             checkAndCallPreload(entityID, true);
         }
     }
@@ -122,7 +129,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = _entityScriptShards.getEngine(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -151,6 +159,21 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString NUM_SCRIPT_ENGINES_OPTION = "num_script_engines";
+
+    if (entityScriptServerSettings.contains(NUM_SCRIPT_ENGINES_OPTION)) {
+        int numScriptEngines = std::max(0, entityScriptServerSettings[NUM_SCRIPT_ENGINES_OPTION].toInt());
+        if (numScriptEngines != _numScriptEngines) {
+            _numScriptEngines = numScriptEngines;
+
+            // restarting the engines restarts every script, so running engines keep going until the next clear()
+            if (!_shuttingDown && _entityScriptShards.getNumRunningEntityScripts() == 0) {
+                stopEntitiesScriptEngines();
+                resetEntitiesScriptEngines();
+            }
+        }
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -167,7 +190,7 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entityScriptShards.getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplaction would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -254,8 +277,9 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(&_entityScriptShards);
 
     // we need to make sure that init has been called for our EntityScriptingInterface
     // so that it actually has a jurisdiction listener when we ask it for it next
@@ -414,57 +438,70 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
-    auto newEngine = QSharedPointer<ScriptEngine>(new ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName),
-                                                  &ScriptEngine::deleteLater);
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+    for (auto& engine : _entityScriptShards.getEngines()) {
+        disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+        engine->unloadAllEntityScripts();
+        engine->stop();
+    }
+    _entityScriptShards.setEngines(QVector<ScriptEnginePointer>());
+}
 
-    auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
-    newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    int numEngines = _numScriptEngines > 0 ? _numScriptEngines : std::max(QThread::idealThreadCount(), 1);
 
-    newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCache>().data());
+    QVector<ScriptEnginePointer> engines;
+    for (int i = 0; i < numEngines; ++i) {
+        auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+        auto newEngine = ScriptEnginePointer(new ScriptEngine(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName),
+                                             &ScriptEngine::deleteLater);
 
-    // connect this script engines printedMessage signal to the global ScriptEngines these various messages
-    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
-    connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
-    connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
-    connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
-    connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+        auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
+        newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+        newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCache>().data());
+
+        // connect this script engines printedMessage signal to the global ScriptEngines these various messages
+        auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
+        connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
+        connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
+        connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
+        connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+
+        // the tree is shared by all of the engines, the first one drives its updates
+        if (i == 0) {
+            connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+                _entityViewer.queryOctree();
+                _entityViewer.getTree()->update();
+            });
+        }
 
+        connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
 
-    newEngine->runInThread();
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngine.data());
+        newEngine->runInThread();
+        engines.push_back(newEngine);
+    }
 
-    disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+    _entityScriptShards.setEngines(engines);
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-    }
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (auto& engine : _entityScriptShards.getEngines()) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -476,37 +513,56 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        auto engine = _entityScriptShards.releaseEntity(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+        }
     }
 }
 
 void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID, const bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    auto engine = _entityScriptShards.getEngine(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && engine) {
+        engine->unloadEntityScript(entityID, true);
         checkAndCallPreload(entityID, reload);
     }
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, const bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    auto engine = _entityScriptShards.getEngine(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && engine) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool notRunning = !_entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool notRunning = !engine->getEntityScriptDetails(entityID, details);
         if (entity && (reload || notRunning || details.scriptText != entity->getServerScripts())) {
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = ResourceManager::normalizeURL(scriptUrl);
                 qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID;
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, reload);
+                engine->loadEntityScript(entityID, scriptUrl, reload);
             }
         }
     }
 }
 
-void EntityScriptServer::sendStatsPacket() {
+void EntityScriptServer::rebalanceEntityScripts() {
+    if (_shuttingDown) {
+        return;
+    }
+
+    auto movedEntityID = _entityScriptShards.rebalance();
+    if (!movedEntityID.isNull()) {
+        // the script was unloaded from its previous engine, start it again in its new one
+        checkAndCallPreload(movedEntityID, true);
+    }
+}
 
+void EntityScriptServer::sendStatsPacket() {
+    QJsonObject statsObject;
+    statsObject["entity_scripts"] = _entityScriptShards.getStats();
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
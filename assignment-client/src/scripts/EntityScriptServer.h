@@ -24,8 +24,11 @@
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 
+#include "EntityScriptShards.h"
+
 static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
+static const int DEFAULT_NUM_SCRIPT_ENGINES = 0; // one per core
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -57,11 +60,14 @@ private slots:
 
     void pushLogs();
 
+    void rebalanceEntityScripts();
+
 private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void stopEntitiesScriptEngines();
+    void resetEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
 
@@ -75,7 +81,8 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    QSharedPointer<ScriptEngine> _entitiesScriptEngine;
+    EntityScriptShards _entityScriptShards;
+    int _numScriptEngines { DEFAULT_NUM_SCRIPT_ENGINES };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
@@ -0,0 +1,185 @@
+//
+//  EntityScriptShards.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptShards.h"
+
+#include <QtCore/QJsonArray>
+
+#include <SharedUtil.h>
+
+#include "EntityScriptServerLogging.h"
+
+// don't bother moving scripts until the busiest engine is running them this much of the time
+static const float MIN_LOAD_TO_REBALANCE = 0.25f;
+
+// nor if the idlest engine is already this close to the busiest one, moving a script restarts it
+static const float MIN_LOAD_RATIO_TO_REBALANCE = 0.5f;
+
+void EntityScriptShards::setEngines(const QVector<ScriptEnginePointer>& engines) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines = engines;
+    _movedEntities.clear();
+
+    _lastRebalance = usecTimestampNow();
+    _shardExecutionTimes = QVector<quint64>(engines.size(), 0);
+    _lastRebalancePeriod = 0;
+}
+
+QVector<ScriptEnginePointer> EntityScriptShards::getEngines() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _engines;
+}
+
+int EntityScriptShards::getShard(const EntityItemID& entityID) const {
+    auto it = _movedEntities.constFind(entityID);
+    if (it != _movedEntities.constEnd()) {
+        return it.value();
+    }
+    return qHash(entityID) % _engines.size();
+}
+
+ScriptEnginePointer EntityScriptShards::getEngine(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_engines.isEmpty()) {
+        return ScriptEnginePointer();
+    }
+    return _engines[getShard(entityID)];
+}
+
+ScriptEnginePointer EntityScriptShards::releaseEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_engines.isEmpty()) {
+        return ScriptEnginePointer();
+    }
+    auto engine = _engines[getShard(entityID)];
+    _movedEntities.remove(entityID);
+    return engine;
+}
+
+int EntityScriptShards::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (auto& engine : getEngines()) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+EntityItemID EntityScriptShards::rebalance() {
+    auto engines = getEngines();
+    if (engines.isEmpty()) {
+        return EntityItemID();
+    }
+
+    quint64 now = usecTimestampNow();
+    _lastRebalancePeriod = now - _lastRebalance;
+    _lastRebalance = now;
+
+    QVector<QHash<EntityItemID, quint64>> entityExecutionTimes(engines.size());
+    int busiestShard = 0;
+    int idlestShard = 0;
+    for (int shard = 0; shard < engines.size(); ++shard) {
+        entityExecutionTimes[shard] = engines[shard]->takeEntityScriptExecutionTimes();
+
+        quint64 shardExecutionTime = 0;
+        for (auto executionTime : entityExecutionTimes[shard]) {
+            shardExecutionTime += executionTime;
+        }
+        _shardExecutionTimes[shard] = shardExecutionTime;
+
+        if (shardExecutionTime > _shardExecutionTimes[busiestShard]) {
+            busiestShard = shard;
+        }
+        if (shardExecutionTime < _shardExecutionTimes[idlestShard]) {
+            idlestShard = shard;
+        }
+    }
+
+    quint64 busiestTime = _shardExecutionTimes[busiestShard];
+    quint64 idlestTime = _shardExecutionTimes[idlestShard];
+    if (busiestTime < MIN_LOAD_TO_REBALANCE * _lastRebalancePeriod ||
+        idlestTime > MIN_LOAD_RATIO_TO_REBALANCE * busiestTime) {
+        return EntityItemID();
+    }
+
+    // the script that evens the two engines out best, any script taking less than the gap between them helps
+    quint64 gap = busiestTime - idlestTime;
+    EntityItemID entityToMove;
+    quint64 bestDistance = gap / 2;
+    const auto& busiestEntityTimes = entityExecutionTimes[busiestShard];
+    for (auto it = busiestEntityTimes.constBegin(); it != busiestEntityTimes.constEnd(); ++it) {
+        quint64 distance = it.value() > gap / 2 ? it.value() - gap / 2 : gap / 2 - it.value();
+        if (it.value() < gap && distance < bestDistance) {
+            entityToMove = it.key();
+            bestDistance = distance;
+        }
+    }
+
+    if (entityToMove.isNull()) {
+        return EntityItemID();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_engines != engines || getShard(entityToMove) != busiestShard) {
+            // the engines were reset, or the script was deleted or reloaded elsewhere in the meantime
+            return EntityItemID();
+        }
+        if (qHash(entityToMove) % _engines.size() == (uint)idlestShard) {
+            _movedEntities.remove(entityToMove);
+        } else {
+            _movedEntities[entityToMove] = idlestShard;
+        }
+    }
+    ++_numMovedEntities;
+
+    qCDebug(entity_script_server) << "Moving the script of" << entityToMove << "from engine" << busiestShard
+        << "to engine" << idlestShard;
+
+    engines[busiestShard]->unloadEntityScript(entityToMove, true);
+    return entityToMove;
+}
+
+QJsonObject EntityScriptShards::getStats() const {
+    auto engines = getEngines();
+
+    QJsonArray enginesStats;
+    for (int shard = 0; shard < engines.size(); ++shard) {
+        QJsonObject engineStats;
+        engineStats["running_scripts"] = engines[shard]->getNumRunningEntityScripts();
+        if (shard < _shardExecutionTimes.size()) {
+            engineStats["execution_usecs"] = (double)_shardExecutionTimes[shard];
+            engineStats["load"] = _lastRebalancePeriod > 0 ?
+                (double)_shardExecutionTimes[shard] / (double)_lastRebalancePeriod : 0.0;
+        }
+        enginesStats.push_back(engineStats);
+    }
+
+    QJsonObject stats;
+    stats["engines"] = enginesStats;
+    stats["moved_scripts"] = _numMovedEntities;
+    return stats;
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params) {
+    // called outside of the lock, the script method may call back into this
+    auto engine = getEngine(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params);
+    }
+}
+
+QFuture<QVariant> EntityScriptShards::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngine(entityID);
+    if (engine) {
+        return engine->getLocalEntityScriptDetails(entityID);
+    }
+    return QFuture<QVariant>();
+}
@@ -0,0 +1,68 @@
+//
+//  EntityScriptShards.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptShards_h
+#define hifi_EntityScriptShards_h
+
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+using ScriptEnginePointer = QSharedPointer<ScriptEngine>;
+
+// Spreads the entity server scripts across several ScriptEngines, each running on its own thread
+//   An entity's script runs in the engine its ID hashes to, unless rebalance() moved it to a less loaded one.
+//   Engines are set and rebalanced from the EntityScriptServer's thread, while the provider calls can come from any
+//   engine's thread.
+class EntityScriptShards : public EntitiesScriptEngineProvider {
+public:
+    void setEngines(const QVector<ScriptEnginePointer>& engines);
+    QVector<ScriptEnginePointer> getEngines() const;
+
+    // returns the engine that runs (or would run) the entity's script, or nullptr if there are no engines
+    ScriptEnginePointer getEngine(const EntityItemID& entityID) const;
+
+    // forgets where the deleted entity's script was moved to, and returns the engine that was running it
+    ScriptEnginePointer releaseEntity(const EntityItemID& entityID);
+
+    int getNumRunningEntityScripts() const;
+
+    // measures the load of each engine since the last call, and if they are uneven enough moves one running script
+    // from the busiest engine to the idlest one. Returns the moved entity, whose script must then be loaded again.
+    EntityItemID rebalance();
+
+    QJsonObject getStats() const;
+
+    virtual void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                        const QStringList& params = QStringList()) override;
+    virtual QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    // requires _mutex
+    int getShard(const EntityItemID& entityID) const;
+
+    mutable std::mutex _mutex;
+    QVector<ScriptEnginePointer> _engines;
+    QHash<EntityItemID, int> _movedEntities; // shard of the entities no longer in the one their ID hashes to
+
+    // measured by rebalance(), on the EntityScriptServer's thread
+    quint64 _lastRebalance { 0 };
+    QVector<quint64> _shardExecutionTimes; // usecs spent running scripts during the last rebalance period
+    quint64 _lastRebalancePeriod { 0 };
+    int _numMovedEntities { 0 };
+};
+
+#endif // hifi_EntityScriptShards_h
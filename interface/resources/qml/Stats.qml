@@ -280,6 +280,9 @@ Item {
                     StatText {
                         text: "  Pending Transfer: " + root.texturePendingTransfers + " MB";
                     }
+                    StatText {
+                        text: "  Frame Transfer: " + root.textureFrameTransfers + " KB in " + root.textureFrameTransferTime.toFixed(2) + " ms";
+                    }
                     StatText {
                         text: "  Resource Memory: " + root.gpuTextureMemory + " MB";
                     }
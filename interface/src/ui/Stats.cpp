@@ -349,6 +349,8 @@ void Stats::updateStats(bool force) {
 
     STAT_UPDATE(qmlTextureMemory, (int)BYTES_TO_MB(OffscreenQmlSurface::getUsedTextureMemory()));
     STAT_UPDATE(texturePendingTransfers, (int)BYTES_TO_MB(gpu::Texture::getTextureTransferPendingSize()));
+    STAT_UPDATE(textureFrameTransfers, (int)BYTES_TO_KB(gpu::Texture::getTextureFrameTransferSize()));
+    STAT_UPDATE(textureFrameTransferTime, (float)gpu::Texture::getTextureFrameTransferUsecs() / (float)USECS_PER_MSEC);
     STAT_UPDATE(gpuTextureMemory, (int)BYTES_TO_MB(gpu::Texture::getTextureGPUMemoryUsage()));
     STAT_UPDATE(gpuTextureVirtualMemory, (int)BYTES_TO_MB(gpu::Texture::getTextureGPUVirtualMemoryUsage()));
     STAT_UPDATE(gpuTextureFramebufferMemory, (int)BYTES_TO_MB(gpu::Texture::getTextureGPUFramebufferMemoryUsage()));
@@ -119,6 +119,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, glContextSwapchainMemory, 0)
     STATS_PROPERTY(int, qmlTextureMemory, 0)
     STATS_PROPERTY(int, texturePendingTransfers, 0)
+    STATS_PROPERTY(int, textureFrameTransfers, 0)
+    STATS_PROPERTY(float, textureFrameTransferTime, 0)
     STATS_PROPERTY(int, gpuTextureMemory, 0)
     STATS_PROPERTY(int, gpuTextureVirtualMemory, 0)
     STATS_PROPERTY(int, gpuTextureFramebufferMemory, 0)
@@ -238,6 +240,8 @@ signals:
     void glContextSwapchainMemoryChanged();
     void qmlTextureMemoryChanged();
     void texturePendingTransfersChanged();
+    void textureFrameTransfersChanged();
+    void textureFrameTransferTimeChanged();
     void gpuBuffersChanged();
     void gpuBufferMemoryChanged();
     void gpuTexturesChanged();
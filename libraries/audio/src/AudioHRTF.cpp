@@ -232,6 +232,66 @@ static void FIR_1x4_SSE(float* src, float* dst0, float* dst1, float* dst2, float
     }
 }
 
+// 2 channel input, 4 channel output
+static void FIR_2x4_SSE(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        __m128 acc2 = _mm_setzero_ps();
+        __m128 acc3 = _mm_setzero_ps();
+
+        float* ps0 = &src0[i - HRTF_TAPS + 1];  // process forwards
+        float* ps1 = &src1[i - HRTF_TAPS + 1];
+
+        assert(HRTF_TAPS % 4 == 0);
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            __m128 x0 = _mm_loadu_ps(&ps0[k+0]);
+            __m128 y0 = _mm_loadu_ps(&ps1[k+0]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-0]), x0));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-0]), x0));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-0]), y0));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-0]), y0));
+
+            __m128 x1 = _mm_loadu_ps(&ps0[k+1]);
+            __m128 y1 = _mm_loadu_ps(&ps1[k+1]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-1]), x1));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-1]), x1));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-1]), y1));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-1]), y1));
+
+            __m128 x2 = _mm_loadu_ps(&ps0[k+2]);
+            __m128 y2 = _mm_loadu_ps(&ps1[k+2]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-2]), x2));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-2]), x2));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-2]), y2));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-2]), y2));
+
+            __m128 x3 = _mm_loadu_ps(&ps0[k+3]);
+            __m128 y3 = _mm_loadu_ps(&ps1[k+3]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-3]), x3));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-3]), x3));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-3]), y3));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-3]), y3));
+        }
+
+        _mm_storeu_ps(&dst0[i], acc0);
+        _mm_storeu_ps(&dst1[i], acc1);
+        _mm_storeu_ps(&dst2[i], acc2);
+        _mm_storeu_ps(&dst3[i], acc3);
+    }
+}
+
 //
 // Runtime CPU dispatch
 //
@@ -246,6 +306,14 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
 }
 
+void FIR_2x4_AVX2(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+
+static void FIR_2x4(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    static auto f = cpuSupportsAVX2() ? FIR_2x4_AVX2 : FIR_2x4_SSE;
+    (*f)(src0, src1, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -389,6 +457,33 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
     }
 }
 
+// sum 4 inputs into 2 outputs with accumulation (interleaved)
+// accumulates in the same order as two calls to crossfade_4x2
+static void sum_4x2(float* src, float* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 x0 = _mm_loadu_ps(&src[4*i+0]);
+        __m128 x1 = _mm_loadu_ps(&src[4*i+4]);
+        __m128 x2 = _mm_loadu_ps(&src[4*i+8]);
+        __m128 x3 = _mm_loadu_ps(&src[4*i+12]);
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        // accumulate first pair, then second pair
+        y0 = _mm_add_ps(y0, _mm_movelh_ps(x0, x1));
+        y1 = _mm_add_ps(y1, _mm_movelh_ps(x2, x3));
+        y0 = _mm_add_ps(y0, _mm_movehl_ps(x1, x0));
+        y1 = _mm_add_ps(y1, _mm_movehl_ps(x3, x2));
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
 // linear interpolation with gain
 static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
 
@@ -475,6 +570,42 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     }
 }
 
+// 2 channel input, 4 channel output
+static void FIR_2x4(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float* ps0 = &src0[i - HRTF_TAPS + 1];  // process forwards
+        float* ps1 = &src1[i - HRTF_TAPS + 1];
+
+        for (int j = 0; j < 4; j++) {
+            dst0[i+j] = 0.0f;
+            dst1[i+j] = 0.0f;
+            dst2[i+j] = 0.0f;
+            dst3[i+j] = 0.0f;
+        }
+
+        assert(HRTF_TAPS % 4 == 0);
+
+        // same arithmetic as FIR_1x4, with channels 0-1 from src0 and channels 2-3 from src1
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+            for (int j = 0; j < 4; j++) {
+                dst0[i+j] += coef0[-k-0] * ps0[k+j+0] + coef0[-k-1] * ps0[k+j+1] + coef0[-k-2] * ps0[k+j+2] + coef0[-k-3] * ps0[k+j+3];
+                dst1[i+j] += coef1[-k-0] * ps0[k+j+0] + coef1[-k-1] * ps0[k+j+1] + coef1[-k-2] * ps0[k+j+2] + coef1[-k-3] * ps0[k+j+3];
+                dst2[i+j] += coef2[-k-0] * ps1[k+j+0] + coef2[-k-1] * ps1[k+j+1] + coef2[-k-2] * ps1[k+j+2] + coef2[-k-3] * ps1[k+j+3];
+                dst3[i+j] += coef3[-k-0] * ps1[k+j+0] + coef3[-k-1] * ps1[k+j+1] + coef3[-k-2] * ps1[k+j+2] + coef3[-k-3] * ps1[k+j+3];
+            }
+        }
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -669,6 +800,20 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
     }
 }
 
+// sum 4 inputs into 2 outputs with accumulation (interleaved)
+// accumulates in the same order as two calls to crossfade_4x2
+static void sum_4x2(float* src, float* dst, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        dst[2*i+0] += src[4*i+0];
+        dst[2*i+1] += src[4*i+1];
+
+        dst[2*i+0] += src[4*i+2];
+        dst[2*i+1] += src[4*i+3];
+    }
+}
+
 // linear interpolation with gain
 static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
 
@@ -950,3 +1095,131 @@ void AudioHRTF::renderSilent(int16_t* input, float* output, int index, float azi
 
     _silentState = true;
 }
+
+bool AudioHRTF::isStatic(float azimuth, float distance, float gain) const {
+    return !_silentState && 
+           azimuth == _azimuthState && 
+           distance == _distanceState && 
+           gain * _gainAdjust == _gainState;
+}
+
+void AudioHRTF::renderBatch(AudioHRTF* hrtfs[], int16_t* inputs[], float* output, int index, 
+                            const float azimuths[], const float distances[], const float gains[], 
+                            int numSources, int numFrames) {
+
+    int i = 0;
+    while (i < numSources) {
+
+        // pairs of static sources share one pass of the 4-channel kernels
+        if (i + 1 < numSources && 
+            hrtfs[i+0]->isStatic(azimuths[i+0], distances[i+0], gains[i+0]) && 
+            hrtfs[i+1]->isStatic(azimuths[i+1], distances[i+1], gains[i+1])) {
+
+            renderStaticPair(*hrtfs[i+0], *hrtfs[i+1], inputs[i+0], inputs[i+1], output, index, numFrames);
+            i += 2;
+
+        } else {
+
+            hrtfs[i]->render(inputs[i], output, index, azimuths[i], distances[i], gains[i], numFrames);
+            i += 1;
+        }
+    }
+}
+
+void AudioHRTF::renderStaticPair(AudioHRTF& a, AudioHRTF& b, int16_t* inputA, int16_t* inputB, float* output, 
+                                 int index, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float inA[HRTF_TAPS + HRTF_BLOCK];              // mono
+    ALIGN32 float inB[HRTF_TAPS + HRTF_BLOCK];              // mono
+    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
+    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
+    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
+    ALIGN32 float bqState[3][8] = {};                       // 4-channel (interleaved)
+    int delay[4];                                           // 4-channel (interleaved)
+
+    //
+    // Both sources have unchanged parameters, so the old/new crossfade of render() is an identity.
+    // Source a takes the channels of the old filters, and source b takes those of the new filters.
+    //
+    setFilters(firCoef, bqCoef, delay, index, a._azimuthState, a._distanceState, a._gainState, L0);
+    setFilters(firCoef, bqCoef, delay, index, b._azimuthState, b._distanceState, b._gainState, L1);
+
+    // convert mono inputs to float
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        inA[HRTF_TAPS+i] = (float)inputA[i] * (1/32768.0f);
+        inB[HRTF_TAPS+i] = (float)inputB[i] * (1/32768.0f);
+    }
+
+    // FIR state update
+    memcpy(inA, a._firState, HRTF_TAPS * sizeof(float));
+    memcpy(inB, b._firState, HRTF_TAPS * sizeof(float));
+    memcpy(a._firState, &inA[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
+    memcpy(b._firState, &inB[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
+
+    // process a/b FIR
+    FIR_2x4(&inA[HRTF_TAPS], 
+            &inB[HRTF_TAPS], 
+            &firBuffer[L0][HRTF_DELAY], 
+            &firBuffer[R0][HRTF_DELAY], 
+            &firBuffer[L1][HRTF_DELAY], 
+            &firBuffer[R1][HRTF_DELAY], 
+            firCoef, HRTF_BLOCK);
+
+    // delay state update
+    memcpy(firBuffer[L0], a._delayState[L1], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[R0], a._delayState[R1], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[L1], b._delayState[L1], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[R1], b._delayState[R1], HRTF_DELAY * sizeof(float));
+
+    memcpy(a._delayState[L0], &firBuffer[L0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(a._delayState[R0], &firBuffer[R0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(a._delayState[L1], &firBuffer[L0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(a._delayState[R1], &firBuffer[R0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+
+    memcpy(b._delayState[L0], &firBuffer[L1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(b._delayState[R0], &firBuffer[R1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(b._delayState[L1], &firBuffer[L1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(b._delayState[R1], &firBuffer[R1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+
+    // interleave with a/b integer delay
+    interleave_4x4(&firBuffer[L0][HRTF_DELAY] - delay[L0],
+                   &firBuffer[R0][HRTF_DELAY] - delay[R0],
+                   &firBuffer[L1][HRTF_DELAY] - delay[L1],
+                   &firBuffer[R1][HRTF_DELAY] - delay[R1],
+                   bqBuffer, HRTF_BLOCK);
+
+    // gather biquad history
+    for (int k = 0; k < 3; k++) {
+        bqState[k][L0] = a._bqState[k][L1];
+        bqState[k][R0] = a._bqState[k][R1];
+        bqState[k][L1] = b._bqState[k][L1];
+        bqState[k][R1] = b._bqState[k][R1];
+        bqState[k][L2] = a._bqState[k][L3];
+        bqState[k][R2] = a._bqState[k][R3];
+        bqState[k][L3] = b._bqState[k][L3];
+        bqState[k][R3] = b._bqState[k][R3];
+    }
+
+    // process a/b biquads
+    biquad2_4x4(bqBuffer, bqBuffer, bqCoef, bqState, HRTF_BLOCK);
+
+    // scatter biquad history, as both old and new state
+    for (int k = 0; k < 3; k++) {
+        a._bqState[k][L0] = a._bqState[k][L1] = bqState[k][L0];
+        a._bqState[k][R0] = a._bqState[k][R1] = bqState[k][R0];
+        b._bqState[k][L0] = b._bqState[k][L1] = bqState[k][L1];
+        b._bqState[k][R0] = b._bqState[k][R1] = bqState[k][R1];
+        a._bqState[k][L2] = a._bqState[k][L3] = bqState[k][L2];
+        a._bqState[k][R2] = a._bqState[k][R3] = bqState[k][R2];
+        b._bqState[k][L2] = b._bqState[k][L3] = bqState[k][L3];
+        b._bqState[k][R2] = b._bqState[k][R3] = bqState[k][R3];
+    }
+
+    // accumulate a, then b
+    sum_4x2(bqBuffer, output, HRTF_BLOCK);
+}
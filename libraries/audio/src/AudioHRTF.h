@@ -44,6 +44,17 @@ public:
     //
     void renderSilent(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
 
+    //
+    // Render a batch of mono sources into one output, with the same result as calling render() on each in order.
+    // Consecutive sources with unchanged azimuth, distance and gain skip the crossfade and are processed in pairs.
+    //
+    // hrtfs, inputs, azimuths, distances, gains: per-source arguments as for render()
+    // numSources: number of sources in the batch
+    //
+    static void renderBatch(AudioHRTF* hrtfs[], int16_t* inputs[], float* output, int index, 
+                            const float azimuths[], const float distances[], const float gains[], 
+                            int numSources, int numFrames);
+
     //
     // HRTF local gain adjustment in amplitude (1.0 == unity)
     //
@@ -54,6 +65,13 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // true if rendering with these parameters would not change the filters
+    bool isStatic(float azimuth, float distance, float gain) const;
+
+    // render two static sources with a single pass of the 4-channel kernels
+    static void renderStaticPair(AudioHRTF& a, AudioHRTF& b, int16_t* inputA, int16_t* inputB, float* output, 
+                                 int index, int numFrames);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
@@ -177,49 +177,17 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail) {
                         &_outboundDataRate);
 }
 
-QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
-    AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust, 
-    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut) const {
+AvatarDataPacket::HasFlags AvatarData::getHasFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const {
+    if (dataDetail == NoData) {
+        return 0;
+    }
 
-    bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
     bool sendMinimum = (dataDetail == MinimumData);
     bool sendPALMinimum = (dataDetail == PALMinimum);
 
     lazyInitHeadData();
 
-    QByteArray avatarDataByteArray(udt::MAX_PACKET_SIZE, 0);
-    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(avatarDataByteArray.data());
-    unsigned char* startPosition = destinationBuffer;
-
-    // special case, if we were asked for no data, then just include the flags all set to nothing
-    if (dataDetail == NoData) {
-        AvatarDataPacket::HasFlags packetStateFlags = 0;
-        memcpy(destinationBuffer, &packetStateFlags, sizeof(packetStateFlags));
-        return avatarDataByteArray.left(sizeof(packetStateFlags));
-    }
-
-    // FIXME -
-    //
-    //    BUG -- if you enter a space bubble, and then back away, the avatar has wrong orientation until "send all" happens... 
-    //      this is an iFrame issue... what to do about that?
-    //
-    //    BUG -- Resizing avatar seems to "take too long"... the avatar doesn't redraw at smaller size right away
-    //
-    // TODO consider these additional optimizations in the future
-    // 1) SensorToWorld - should we only send this for avatars with attachments?? - 20 bytes - 7.20 kbps
-    // 2) GUIID for the session change to 2byte index                   (savings) - 14 bytes - 5.04 kbps
-    // 3) Improve Joints -- currently we use rotational tolerances, but if we had skeleton/bone length data
-    //    we could do a better job of determining if the change in joints actually translates to visible
-    //    changes at distance.
-    //
-    //    Potential savings:
-    //              63 rotations   * 6 bytes = 136kbps
-    //              3 translations * 6 bytes = 6.48kbps
-    //
-
-    auto parentID = getParentID();
-
     bool hasAvatarGlobalPosition = true; // always include global position
     bool hasAvatarOrientation = false;
     bool hasAvatarBoundingBox = false;
@@ -257,9 +225,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         hasJointData = sendAll || !sendMinimum;
     }
 
-    // Leading flags, to indicate how much data is actually included in the packet...
-    AvatarDataPacket::HasFlags packetStateFlags =
-        (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
+    return (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
         | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
         | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
         | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
@@ -271,6 +237,64 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
         | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
         | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0);
+}
+
+QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
+    AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust, 
+    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut) const {
+
+    bool cullSmallChanges = (dataDetail == CullSmallData);
+    bool sendAll = (dataDetail == SendAllData);
+
+    lazyInitHeadData();
+
+    QByteArray avatarDataByteArray(udt::MAX_PACKET_SIZE, 0);
+    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(avatarDataByteArray.data());
+    unsigned char* startPosition = destinationBuffer;
+
+    // special case, if we were asked for no data, then just include the flags all set to nothing
+    if (dataDetail == NoData) {
+        AvatarDataPacket::HasFlags packetStateFlags = 0;
+        memcpy(destinationBuffer, &packetStateFlags, sizeof(packetStateFlags));
+        return avatarDataByteArray.left(sizeof(packetStateFlags));
+    }
+
+    // FIXME -
+    //
+    //    BUG -- if you enter a space bubble, and then back away, the avatar has wrong orientation until "send all" happens... 
+    //      this is an iFrame issue... what to do about that?
+    //
+    //    BUG -- Resizing avatar seems to "take too long"... the avatar doesn't redraw at smaller size right away
+    //
+    // TODO consider these additional optimizations in the future
+    // 1) SensorToWorld - should we only send this for avatars with attachments?? - 20 bytes - 7.20 kbps
+    // 2) GUIID for the session change to 2byte index                   (savings) - 14 bytes - 5.04 kbps
+    // 3) Improve Joints -- currently we use rotational tolerances, but if we had skeleton/bone length data
+    //    we could do a better job of determining if the change in joints actually translates to visible
+    //    changes at distance.
+    //
+    //    Potential savings:
+    //              63 rotations   * 6 bytes = 136kbps
+    //              3 translations * 6 bytes = 6.48kbps
+    //
+
+    auto parentID = getParentID();
+
+    // Leading flags, to indicate how much data is actually included in the packet...
+    AvatarDataPacket::HasFlags packetStateFlags = getHasFlags(dataDetail, lastSentTime, dropFaceTracking);
+
+    bool hasAvatarGlobalPosition = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION;
+    bool hasAvatarOrientation = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION;
+    bool hasAvatarBoundingBox = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX;
+    bool hasAvatarScale = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_SCALE;
+    bool hasLookAtPosition = packetStateFlags & AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION;
+    bool hasAudioLoudness = packetStateFlags & AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS;
+    bool hasSensorToWorldMatrix = packetStateFlags & AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX;
+    bool hasAdditionalFlags = packetStateFlags & AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS;
+    bool hasParentInfo = packetStateFlags & AvatarDataPacket::PACKET_HAS_PARENT_INFO;
+    bool hasAvatarLocalPosition = packetStateFlags & AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION;
+    bool hasFaceTrackerInfo = packetStateFlags & AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO;
+    bool hasJointData = packetStateFlags & AvatarDataPacket::PACKET_HAS_JOINT_DATA;
 
     memcpy(destinationBuffer, &packetStateFlags, sizeof(packetStateFlags));
     destinationBuffer += sizeof(packetStateFlags);
@@ -2359,8 +2383,6 @@ void AvatarData::sortAvatars(
     PROFILE_RANGE(simulation, "sort");
     uint64_t now = usecTimestampNow();
 
-    glm::vec3 frustumCenter = cameraView.getPosition();
-    const glm::vec3& forward = cameraView.getDirection();
     for (int32_t i = 0; i < avatarList.size(); ++i) {
         const auto& avatar = avatarList.at(i);
 
@@ -2368,39 +2390,44 @@ void AvatarData::sortAvatars(
             continue;
         }
 
-        // priority = weighted linear combination of:
-        //   (a) apparentSize
-        //   (b) proximity to center of view
-        //   (c) time since last update
-        glm::vec3 avatarPosition = avatar->getPosition();
-        glm::vec3 offset = avatarPosition - frustumCenter;
-        float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
-
         // FIXME - AvatarData has something equivolent to this
         float radius = getBoundingRadius(avatar);
 
-        float apparentSize = 2.0f * radius / distance;
-        float cosineAngle = glm::dot(offset, forward) / distance;
-        float age = (float)(now - getLastUpdated(avatar)) / (float)(USECS_PER_SECOND);
-
-        // NOTE: we are adding values of different units to get a single measure of "priority".
-        // Thus we multiply each component by a conversion "weight" that scales its units relative to the others.
-        // These weights are pure magic tuning and should be hard coded in the relation below,
-        // but are currently exposed for anyone who would like to explore fine tuning:
-        float priority = _avatarSortCoefficientSize * apparentSize
-            + _avatarSortCoefficientCenter * cosineAngle
-            + _avatarSortCoefficientAge * age;
-
-        // decrement priority of avatars outside keyhole
-        if (distance > cameraView.getCenterRadius()) {
-            if (!cameraView.sphereIntersectsFrustum(avatarPosition, radius)) {
-                priority += OUT_OF_VIEW_PENALTY;
-            }
-        }
+        float priority = computeSortPriority(cameraView, avatar->getPosition(), radius, getLastUpdated(avatar), now);
         sortedAvatarsOut.push(AvatarPriority(avatar, priority));
     }
 }
 
+float AvatarData::computeSortPriority(const ViewFrustum& cameraView, const glm::vec3& avatarPosition, float radius,
+                                     uint64_t lastUpdated, uint64_t now) {
+    // priority = weighted linear combination of:
+    //   (a) apparentSize
+    //   (b) proximity to center of view
+    //   (c) time since last update
+    glm::vec3 offset = avatarPosition - cameraView.getPosition();
+    float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
+
+    float apparentSize = 2.0f * radius / distance;
+    float cosineAngle = glm::dot(offset, cameraView.getDirection()) / distance;
+    float age = (float)(now - lastUpdated) / (float)(USECS_PER_SECOND);
+
+    // NOTE: we are adding values of different units to get a single measure of "priority".
+    // Thus we multiply each component by a conversion "weight" that scales its units relative to the others.
+    // These weights are pure magic tuning and should be hard coded in the relation below,
+    // but are currently exposed for anyone who would like to explore fine tuning:
+    float priority = _avatarSortCoefficientSize * apparentSize
+        + _avatarSortCoefficientCenter * cosineAngle
+        + _avatarSortCoefficientAge * age;
+
+    // decrement priority of avatars outside keyhole
+    if (distance > cameraView.getCenterRadius()) {
+        if (!cameraView.sphereIntersectsFrustum(avatarPosition, radius)) {
+            priority += OUT_OF_VIEW_PENALTY;
+        }
+    }
+    return priority;
+}
+
 QScriptValue AvatarEntityMapToScriptValue(QScriptEngine* engine, const AvatarEntityMap& value) {
     QScriptValue obj = engine->newObject();
     for (auto entityID : value.keys()) {
@@ -391,6 +391,11 @@ public:
         AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition, 
         QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut = nullptr) const;
 
+    // returns the leading flags of toByteArray, i.e. which sections it would include
+    AvatarDataPacket::HasFlags getHasFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const;
+
+    float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
+
     virtual void doneEncoding(bool cullSmallChanges);
 
     /// \return true if an error should be logged
@@ -613,6 +618,10 @@ public:
         std::function<float(AvatarSharedPointer)> getBoundingRadius,
         std::function<bool(AvatarSharedPointer)> shouldIgnore);
 
+    // returns the priority used by sortAvatars for an avatar of the given position and bounding radius
+    static float computeSortPriority(const ViewFrustum& cameraView, const glm::vec3& avatarPosition, float radius,
+                                     uint64_t lastUpdated, uint64_t now);
+
     // TODO: remove this HACK once we settle on optimal sort coefficients
     // These coefficients exposed for fine tuning the sort priority for transfering new _jointData to the render pipeline.
     static float _avatarSortCoefficientSize;
@@ -643,7 +652,6 @@ public slots:
 protected:
     void lazyInitHeadData() const;
 
-    float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
     float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
 
     bool avatarBoundingBoxChangedSince(quint64 time) const { return _avatarBoundingBoxChanged >= time; }
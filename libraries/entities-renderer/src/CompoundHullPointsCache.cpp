@@ -0,0 +1,141 @@
+//
+//  CompoundHullPointsCache.cpp
+//  libraries/entities-renderer/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CompoundHullPointsCache.h"
+
+#include <functional>
+#include <unordered_set>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "EntitiesRendererLogging.h"
+
+namespace {
+
+class PointHash {
+public:
+    size_t operator()(const glm::vec3& point) const {
+        std::hash<float> hashFloat;
+        size_t hash = hashFloat(point.x);
+        hash = hash * 31 + hashFloat(point.y);
+        return hash * 31 + hashFloat(point.z);
+    }
+};
+
+class UniquePoints {
+public:
+    UniquePoints(ShapeInfo::PointList& points, int numIndices) : _points(points) {
+        _uniquePoints.reserve(numIndices);
+    }
+
+    void add(const glm::vec3& point) {
+        if (_uniquePoints.insert(point).second) {
+            _points << point;
+        }
+    }
+
+private:
+    ShapeInfo::PointList& _points;
+    std::unordered_set<glm::vec3, PointHash> _uniquePoints;
+};
+
+}
+
+ShapeInfo::PointCollection CompoundHullPointsCache::computePoints(const FBXGeometry& collisionGeometry) {
+    const uint32_t TRIANGLE_STRIDE = 3;
+    const uint32_t QUAD_STRIDE = 4;
+
+    ShapeInfo::PointCollection pointCollection;
+
+    // the way OBJ files get read, each section under a "g" line is its own meshPart.  We only expect
+    // to find one actual "mesh" (with one or more meshParts in it), but we loop over the meshes, just in case.
+    foreach (const FBXMesh& mesh, collisionGeometry.meshes) {
+        // each meshPart is a convex hull
+        foreach (const FBXMeshPart &meshPart, mesh.parts) {
+            ShapeInfo::PointList pointsInPart;
+
+            // run through all the triangles and quads and (uniquely) add each point to the hull
+            uint32_t numTriangleIndices = (uint32_t)meshPart.triangleIndices.size();
+            uint32_t numQuadIndices = (uint32_t)meshPart.quadIndices.size();
+            // TODO: assert rather than workaround after we start sanitizing FBXMesh higher up
+            //assert(numTriangleIndices % TRIANGLE_STRIDE == 0);
+            //assert(numQuadIndices % QUAD_STRIDE == 0);
+            numTriangleIndices -= numTriangleIndices % TRIANGLE_STRIDE; // WORKAROUND lack of sanity checking in FBXReader
+            numQuadIndices -= numQuadIndices % QUAD_STRIDE; // WORKAROUND lack of sanity checking in FBXReader
+
+            UniquePoints uniquePoints(pointsInPart, numTriangleIndices + numQuadIndices);
+            for (uint32_t j = 0; j < numTriangleIndices; ++j) {
+                uniquePoints.add(mesh.vertices[meshPart.triangleIndices[j]]);
+            }
+            for (uint32_t j = 0; j < numQuadIndices; ++j) {
+                uniquePoints.add(mesh.vertices[meshPart.quadIndices[j]]);
+            }
+
+            if (pointsInPart.size() == 0) {
+                qCDebug(entitiesrenderer) << "Warning -- meshPart has no faces";
+                continue;
+            }
+            pointCollection.push_back(pointsInPart);
+        }
+    }
+    return pointCollection;
+}
+
+CompoundHullPointsCache::PointsPointer CompoundHullPointsCache::getPoints(const GeometryResource::Pointer& resource) {
+    if (!resource || !resource->isLoaded()) {
+        return PointsPointer();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    QUrl url = resource->getURL();
+    auto it = _entries.find(url);
+    if (it != _entries.end() && it->resource == resource) {
+        // computed, or being computed, from this very geometry
+        if (it->points) {
+            it->isClaimed = true;
+        }
+        return it->points;
+    }
+
+    collectGarbage();
+
+    Entry& entry = _entries[url];
+    entry.resource = resource;
+    entry.points.reset();
+    entry.isPending = true;
+    entry.isClaimed = false;
+
+    QtConcurrent::run([this, url, resource] {
+        auto points = std::make_shared<const ShapeInfo::PointCollection>(computePoints(resource->getFBXGeometry()));
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(url);
+        if (it != _entries.end() && it->resource == resource) {
+            it->points = points;
+            it->isPending = false;
+        }
+    });
+
+    return PointsPointer();
+}
+
+void CompoundHullPointsCache::collectGarbage() {
+    auto it = _entries.begin();
+    while (it != _entries.end()) {
+        // results nobody asked for yet are kept until their geometry goes away, so they are not recomputed
+        bool isUnused = it->isClaimed && it->points.use_count() == 1;
+        if (!it->isPending && (isUnused || it->resource.isNull())) {
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+//
+//  CompoundHullPointsCache.h
+//  libraries/entities-renderer/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompoundHullPointsCache_h
+#define hifi_CompoundHullPointsCache_h
+
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QUrl>
+
+#include <model-networking/ModelCache.h>
+#include <ShapeInfo.h>
+
+// The unscaled convex hull points of the collision geometries used by compound shape entities
+//   The points of each geometry are de-duplicated once, on a worker thread, and shared by all the entities using it.
+//   Thread-safe.
+class CompoundHullPointsCache {
+public:
+    using PointsPointer = std::shared_ptr<const ShapeInfo::PointCollection>;
+
+    /// \return the hull points of the loaded collision geometry, or nullptr while they are being computed
+    PointsPointer getPoints(const GeometryResource::Pointer& resource);
+
+    /// \return the unique points of each mesh part, one convex hull per part
+    static ShapeInfo::PointCollection computePoints(const FBXGeometry& collisionGeometry);
+
+private:
+    class Entry {
+    public:
+        QWeakPointer<GeometryResource> resource;
+        PointsPointer points;
+        bool isPending { false };
+        bool isClaimed { false }; // the points were handed out at least once
+    };
+
+    // requires _mutex, drops the points no entity is using anymore, and those of geometries that were unloaded
+    void collectGarbage();
+
+    std::mutex _mutex;
+    QHash<QUrl, Entry> _entries;
+};
+
+#endif // hifi_CompoundHullPointsCache_h
@@ -24,6 +24,7 @@
 #include <render/Scene.h>
 #include <DependencyManager.h>
 
+#include "CompoundHullPointsCache.h"
 #include "EntityTreeRenderer.h"
 #include "EntitiesRendererLogging.h"
 #include "RenderableEntityItem.h"
@@ -31,6 +32,7 @@
 #include "RenderableEntityItem.h"
 
 static CollisionRenderMeshCache collisionMeshCache;
+static CompoundHullPointsCache compoundHullPointsCache;
 
 
 EntityItemPointer RenderableModelEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
@@ -614,6 +616,7 @@ void RenderableModelEntityItem::getCollisionGeometryResource() {
     queryArgs.addQueryItem("collision-hull", "");
     hullURL.setQuery(queryArgs);
     _compoundShapeResource = DependencyManager::get<ModelCache>()->getCollisionGeometryResource(hullURL);
+    _compoundHullPoints.reset();
 }
 
 void RenderableModelEntityItem::setShapeType(ShapeType type) {
@@ -625,6 +628,7 @@ void RenderableModelEntityItem::setShapeType(ShapeType type) {
     } else if (_compoundShapeResource && !getCompoundShapeURL().isEmpty()) {
         // the compoundURL has been set but the shapeType does not agree
         _compoundShapeResource.reset();
+        _compoundHullPoints.reset();
     }
 }
 
@@ -667,6 +671,13 @@ bool RenderableModelEntityItem::isReadyToComputeShape() {
         if (_model->isLoaded()) {
             if (_compoundShapeResource && _compoundShapeResource->isLoaded()) {
                 // we have both URLs AND both geometries AND they are both fully loaded.
+                if (!_compoundHullPoints) {
+                    // the hull points are computed in the background, once for all the entities using this geometry
+                    _compoundHullPoints = compoundHullPointsCache.getPoints(_compoundShapeResource);
+                    if (!_compoundHullPoints) {
+                        return false;
+                    }
+                }
                 if (_needsInitialSimulation) {
                     // the _model's offset will be wrong until _needsInitialSimulation is false
                     PerformanceTimer perfTimer("_model->simulate");
@@ -694,7 +705,6 @@ bool RenderableModelEntityItem::isReadyToComputeShape() {
 
 void RenderableModelEntityItem::computeShapeInfo(ShapeInfo& shapeInfo) {
     const uint32_t TRIANGLE_STRIDE = 3;
-    const uint32_t QUAD_STRIDE = 4;
 
     ShapeType type = getShapeType();
     glm::vec3 dimensions = getDimensions();
@@ -704,73 +714,12 @@ void RenderableModelEntityItem::computeShapeInfo(ShapeInfo& shapeInfo) {
         // should never fall in here when collision model not fully loaded
         // hence we assert that all geometries exist and are loaded
         assert(_model && _model->isLoaded() && _compoundShapeResource && _compoundShapeResource->isLoaded());
-        const FBXGeometry& collisionGeometry = _compoundShapeResource->getFBXGeometry();
 
         ShapeInfo::PointCollection& pointCollection = shapeInfo.getPointCollection();
-        pointCollection.clear();
-        uint32_t i = 0;
-
-        // the way OBJ files get read, each section under a "g" line is its own meshPart.  We only expect
-        // to find one actual "mesh" (with one or more meshParts in it), but we loop over the meshes, just in case.
-        foreach (const FBXMesh& mesh, collisionGeometry.meshes) {
-            // each meshPart is a convex hull
-            foreach (const FBXMeshPart &meshPart, mesh.parts) {
-                pointCollection.push_back(QVector<glm::vec3>());
-                ShapeInfo::PointList& pointsInPart = pointCollection[i];
-
-                // run through all the triangles and (uniquely) add each point to the hull
-                uint32_t numIndices = (uint32_t)meshPart.triangleIndices.size();
-                // TODO: assert rather than workaround after we start sanitizing FBXMesh higher up
-                //assert(numIndices % TRIANGLE_STRIDE == 0);
-                numIndices -= numIndices % TRIANGLE_STRIDE; // WORKAROUND lack of sanity checking in FBXReader
-
-                for (uint32_t j = 0; j < numIndices; j += TRIANGLE_STRIDE) {
-                    glm::vec3 p0 = mesh.vertices[meshPart.triangleIndices[j]];
-                    glm::vec3 p1 = mesh.vertices[meshPart.triangleIndices[j + 1]];
-                    glm::vec3 p2 = mesh.vertices[meshPart.triangleIndices[j + 2]];
-                    if (!pointsInPart.contains(p0)) {
-                        pointsInPart << p0;
-                    }
-                    if (!pointsInPart.contains(p1)) {
-                        pointsInPart << p1;
-                    }
-                    if (!pointsInPart.contains(p2)) {
-                        pointsInPart << p2;
-                    }
-                }
-
-                // run through all the quads and (uniquely) add each point to the hull
-                numIndices = (uint32_t)meshPart.quadIndices.size();
-                // TODO: assert rather than workaround after we start sanitizing FBXMesh higher up
-                //assert(numIndices % QUAD_STRIDE == 0);
-                numIndices -= numIndices % QUAD_STRIDE; // WORKAROUND lack of sanity checking in FBXReader
-
-                for (uint32_t j = 0; j < numIndices; j += QUAD_STRIDE) {
-                    glm::vec3 p0 = mesh.vertices[meshPart.quadIndices[j]];
-                    glm::vec3 p1 = mesh.vertices[meshPart.quadIndices[j + 1]];
-                    glm::vec3 p2 = mesh.vertices[meshPart.quadIndices[j + 2]];
-                    glm::vec3 p3 = mesh.vertices[meshPart.quadIndices[j + 3]];
-                    if (!pointsInPart.contains(p0)) {
-                        pointsInPart << p0;
-                    }
-                    if (!pointsInPart.contains(p1)) {
-                        pointsInPart << p1;
-                    }
-                    if (!pointsInPart.contains(p2)) {
-                        pointsInPart << p2;
-                    }
-                    if (!pointsInPart.contains(p3)) {
-                        pointsInPart << p3;
-                    }
-                }
-
-                if (pointsInPart.size() == 0) {
-                    qCDebug(entitiesrenderer) << "Warning -- meshPart has no faces";
-                    pointCollection.pop_back();
-                    continue;
-                }
-                ++i;
-            }
+        if (_compoundHullPoints) {
+            pointCollection = *_compoundHullPoints;
+        } else {
+            pointCollection = CompoundHullPointsCache::computePoints(_compoundShapeResource->getFBXGeometry());
         }
 
         // We expect that the collision model will have the same units and will be displaced
@@ -110,6 +110,7 @@ private:
 
     void getCollisionGeometryResource();
     GeometryResource::Pointer _compoundShapeResource;
+    std::shared_ptr<const ShapeInfo::PointCollection> _compoundHullPoints; // of _compoundShapeResource, unscaled
     ModelPointer _model = nullptr;
     bool _needsInitialSimulation = true;
     bool _needsModelReload = true;
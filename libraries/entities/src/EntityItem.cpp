@@ -185,13 +185,47 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
-    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
-        requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
+    bool isSubsequentPass = false;
+    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->partialEntities.contains(getEntityItemID())) {
+        requestedProperties = entityTreeElementExtraEncodeData->partialEntities.value(getEntityItemID());
+        isSubsequentPass = true;
     }
 
-    LevelDetails entityLevel = packetData->startLevel();
-
     quint64 lastEdited = getLastEdited();
+    quint64 lastUpdated = getLastUpdated();
+    quint64 lastSimulated = getLastSimulated();
+    quint64 changedOnServer = getLastChangedOnServer();
+
+    // the parent ID is converted from AVATAR_SELF_ID to the session UUID, which can change, so that encoding isn't re-used
+    bool canReuseEncoding = !isSubsequentPass && getParentID() != AVATAR_SELF_ID;
+
+    if (canReuseEncoding) {
+        QByteArray encodedData;
+        {
+            std::lock_guard<std::mutex> lock(_encodedDataMutex);
+            if (_encodedData.lastEdited == lastEdited && _encodedData.lastUpdated == lastUpdated &&
+                _encodedData.lastSimulated == lastSimulated && _encodedData.changedOnServer == changedOnServer &&
+                _encodedData.requestedProperties == requestedProperties) {
+                encodedData = _encodedData.bytes;
+            }
+        }
+
+        if (!encodedData.isEmpty()) {
+            // nothing changed since we were last encoded in full, the same bytes can be sent
+            LevelDetails entityLevel = packetData->startLevel();
+            if (packetData->appendRawData((const unsigned char*)encodedData.constData(), encodedData.size())) {
+                packetData->endLevel(entityLevel);
+                params.trackSend(getID(), lastEdited);
+                return OctreeElement::COMPLETED;
+            }
+
+            // it doesn't all fit, encode as much as does
+            packetData->discardLevel(entityLevel);
+        }
+    }
+
+    LevelDetails entityLevel = packetData->startLevel();
+    int startOfEntity = packetData->getUncompressedByteOffset();
 
     #ifdef WANT_DEBUG
         float editedAgo = getEditedAgo();
@@ -323,6 +357,20 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
             assert(newPropertyFlagsLength == oldPropertyFlagsLength); // should not have grown
         }
 
+        if (canReuseEncoding && appendState == OctreeElement::COMPLETED) {
+            // this is a complete encoding, keep it for the next sends
+            int endOfEntity = packetData->getUncompressedByteOffset();
+            QByteArray encodedData((const char*)packetData->getUncompressedData(startOfEntity), endOfEntity - startOfEntity);
+
+            std::lock_guard<std::mutex> lock(_encodedDataMutex);
+            _encodedData.lastEdited = lastEdited;
+            _encodedData.lastUpdated = lastUpdated;
+            _encodedData.lastSimulated = lastSimulated;
+            _encodedData.changedOnServer = changedOnServer;
+            _encodedData.requestedProperties = requestedProperties;
+            _encodedData.bytes = encodedData;
+        }
+
         packetData->endLevel(entityLevel);
     } else {
         packetData->discardLevel(entityLevel);
@@ -332,7 +380,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     // If any part of the model items didn't fit, then the element is considered partial
     if (appendState != OctreeElement::COMPLETED) {
         // add this item into our list for the next appendElementData() pass
-        entityTreeElementExtraEncodeData->entities.insert(getEntityItemID(), propertiesDidntFit);
+        entityTreeElementExtraEncodeData->partialEntities.insert(getEntityItemID(), propertiesDidntFit);
     }
 
     // if any part of our entity was sent, call trackSend
@@ -13,6 +13,7 @@
 #define hifi_EntityItem_h
 
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -498,6 +499,19 @@ protected:
     quint64 _created;
     quint64 _changedOnServer;
 
+    // complete encoding of this entity by appendEntityData, re-used until the entity changes
+    // (shared by the send threads of all clients)
+    struct EncodedEntityData {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 changedOnServer { 0 };
+        EntityPropertyFlags requestedProperties;
+        QByteArray bytes;
+    };
+    mutable std::mutex _encodedDataMutex;
+    mutable EncodedEntityData _encodedData;
+
     mutable AABox _cachedAABox;
     mutable AACube _maxAACube;
     mutable AACube _minAACube;
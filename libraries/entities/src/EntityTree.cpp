@@ -10,7 +10,10 @@
 //
 
 #include <PerfStat.h>
+#include <QDataStream>
 #include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QtScript/QScriptEngine>
 
 #include "EntityTree.h"
@@ -27,6 +30,14 @@
 #include "EntityEditFilters.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
+
+static const char ENTITY_PERSIST_FILE_MAGIC[] = "HFEB";
+static const int ENTITY_PERSIST_FILE_MAGIC_SIZE = 4;
+static const quint32 ENTITY_PERSIST_FILE_VERSION = 1;
+static const QDataStream::Version ENTITY_PERSIST_STREAM_VERSION = QDataStream::Qt_5_6;
+static const quint8 ENTITY_PERSIST_RECORD_PROPERTIES = 1;
+static const quint8 ENTITY_PERSIST_RECORD_DELETED = 2;
+static const int MIN_ENTITY_PERSIST_LOG_RECORDS = 1000; // the log is compacted once longer than this and the snapshot
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 
 
@@ -126,6 +137,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    trackChangedEntity(entity->getEntityItemID());
     emit addingEntity(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
@@ -308,6 +320,7 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         }
 
         _isDirty = true;
+        trackChangedEntity(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -527,8 +540,11 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
 
         if (getIsServer()) {
             // set up the deleted entities ID
-            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-            _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            {
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            }
+            trackEntityToPersist(theEntity->getEntityItemID(), true);
         } else {
             // on the client side, we also remember that we deleted this entity, we don't care about the time
             trackDeletedEntity(theEntity->getEntityItemID());
@@ -1085,7 +1101,7 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         properties.setLastEditedBy(senderNode->getUUID());
                     }
                     updateEntity(entityItemID, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
+                    markEntityChangedOnServer(existingEntity);
                     endUpdate = usecTimestampNow();
                     _totalUpdates++;
                 } else if (isAdd) {
@@ -1106,7 +1122,7 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         endCreate = usecTimestampNow();
                         _totalCreates++;
                         if (newEntity) {
-                            newEntity->markAsChangedOnServer();
+                            markEntityChangedOnServer(newEntity);
                             notifyNewlyCreatedEntity(*newEntity, senderNode);
 
                             startLogging = usecTimestampNow();
@@ -1342,6 +1358,67 @@ void EntityTree::forgetEntitiesDeletedBefore(quint64 sinceTime) {
     }
 }
 
+void EntityTree::markEntityChangedOnServer(EntityItemPointer entity) {
+    entity->markAsChangedOnServer();
+    trackChangedEntity(entity->getEntityItemID());
+}
+
+void EntityTree::trackChangedEntity(const QUuid& id) {
+    if (getIsServer()) {
+        {
+            QWriteLocker locker(&_recentlyChangedEntitiesLock);
+            _recentlyChangedEntityItemIDs.insert(usecTimestampNow(), id);
+        }
+        trackEntityToPersist(id, false);
+    }
+}
+
+bool EntityTree::addElementsChangedSinceToBag(quint64 sinceTime, OctreeElementBag& bag) {
+    QSet<QUuid> changedEntityIDs;
+    {
+        QReadLocker locker(&_recentlyChangedEntitiesLock);
+        if (sinceTime < _recentlyChangedEntitiesSince) {
+            return false;
+        }
+
+        auto iterator = _recentlyChangedEntityItemIDs.lowerBound(sinceTime);
+        while (iterator != _recentlyChangedEntityItemIDs.end()) {
+            changedEntityIDs << iterator.value();
+            ++iterator;
+        }
+    }
+
+    foreach (const QUuid& id, changedEntityIDs) {
+        EntityTreeElementPointer element = getContainingElement(id);
+        if (!element) {
+            // deleted since, and sent as an erase
+            continue;
+        }
+
+        // the data of an element is encoded by its parent, except for the root which encodes its own
+        OctreeElementPointer parent = _rootElement;
+        if (element != _rootElement) {
+            nodeForOctalCode(_rootElement, element->getOctalCode(), &parent);
+        }
+        bag.insert(parent);
+    }
+
+    return true;
+}
+
+// called by the server when it knows all nodes have been sent the changes
+void EntityTree::forgetEntitiesChangedBefore(quint64 sinceTime) {
+    QWriteLocker locker(&_recentlyChangedEntitiesLock);
+
+    // the map is ordered by time, so the older changes are at the front
+    auto iterator = _recentlyChangedEntityItemIDs.begin();
+    while (iterator != _recentlyChangedEntityItemIDs.end() && iterator.key() < sinceTime) {
+        iterator = _recentlyChangedEntityItemIDs.erase(iterator);
+    }
+
+    _recentlyChangedEntitiesSince = std::max(_recentlyChangedEntitiesSince, sinceTime);
+}
+
 
 // TODO: consider consolidating processEraseMessageDetails() and processEraseMessage()
 int EntityTree::processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode) {
@@ -1676,6 +1753,249 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
+void EntityTree::trackEntityToPersist(const QUuid& id, bool isDeleted) {
+    QMutexLocker locker(&_entitiesToPersistLock);
+    if (_binaryPersistFileName.isEmpty()) {
+        // not persisting to a binary file, the next snapshot will have everything
+        return;
+    }
+    if (isDeleted) {
+        _changedEntitiesToPersist.remove(id);
+        _deletedEntitiesToPersist.insert(id);
+    } else {
+        _deletedEntitiesToPersist.remove(id);
+        _changedEntitiesToPersist.insert(id);
+    }
+}
+
+bool EntityTree::writeToBinaryFile(const char* fileName) {
+    QString qFileName(fileName);
+    QVector<EntityItemProperties> entityProperties;
+    QVector<QUuid> deletedEntityIDs;
+    bool isSnapshot = false;
+
+    // only copy the properties under the lock, they are converted and written once it is released
+    withReadLock([&] {
+        QMutexLocker locker(&_entitiesToPersistLock);
+
+        int numRecords = _changedEntitiesToPersist.size() + _deletedEntitiesToPersist.size();
+        isSnapshot = qFileName != _binaryPersistFileName || QFileInfo(qFileName).size() != _binaryPersistFileSize ||
+            _binaryPersistLogRecords + numRecords > std::max(_binaryPersistSnapshotRecords, MIN_ENTITY_PERSIST_LOG_RECORDS);
+
+        // changes made after this are for the next write
+        _binaryPersistFileName = qFileName;
+
+        auto appendIfPersisted = [&](const EntityItemPointer& entity) {
+            if (entity->isParentIDValid()) {
+                entityProperties << entity->getProperties();
+            }
+        };
+
+        if (isSnapshot) {
+            QReadLocker entityToElementLocker(&_entityToElementLock);
+            entityProperties.reserve(_entityToElementMap.size());
+            for (auto it = _entityToElementMap.constBegin(); it != _entityToElementMap.constEnd(); ++it) {
+                EntityItemPointer entity = it.value()->getEntityWithEntityItemID(it.key());
+                if (entity) {
+                    appendIfPersisted(entity);
+                }
+            }
+        } else {
+            foreach (const QUuid& id, _changedEntitiesToPersist) {
+                EntityItemPointer entity = findEntityByEntityItemID(id);
+                if (entity) {
+                    appendIfPersisted(entity);
+                } else {
+                    deletedEntityIDs << id;
+                }
+            }
+            foreach (const QUuid& id, _deletedEntitiesToPersist) {
+                deletedEntityIDs << id;
+            }
+        }
+
+        _changedEntitiesToPersist.clear();
+        _deletedEntitiesToPersist.clear();
+    });
+
+    bool success = isSnapshot ? writeBinarySnapshot(qFileName, entityProperties) :
+        appendToBinaryLog(qFileName, entityProperties, deletedEntityIDs);
+
+    if (!success) {
+        // the changes just taken are not in the file, so the next write has to be a full snapshot
+        QMutexLocker locker(&_entitiesToPersistLock);
+        _binaryPersistFileName.clear();
+    }
+    return success;
+}
+
+static void writeEntityPersistRecord(QDataStream& stream, QScriptEngine& scriptEngine,
+                                     const EntityItemProperties& properties) {
+    // the same non-default property map as the JSON file, but in Qt's binary format
+    QVariant entityVariant = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties).toVariant();
+    stream << ENTITY_PERSIST_RECORD_PROPERTIES << entityVariant;
+}
+
+bool EntityTree::writeBinarySnapshot(const QString& fileName, const QVector<EntityItemProperties>& entityProperties) {
+    qCDebug(entities) << "Saving binary snapshot of" << entityProperties.size() << "entities to file" << fileName;
+
+    // a QSaveFile only replaces the existing file once it has been completely written
+    QSaveFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical() << "Could not open binary entities file" << fileName << "for writing.";
+        return false;
+    }
+
+    QDataStream stream(&persistFile);
+    stream.setVersion(ENTITY_PERSIST_STREAM_VERSION);
+    stream.writeRawData(ENTITY_PERSIST_FILE_MAGIC, ENTITY_PERSIST_FILE_MAGIC_SIZE);
+    stream << ENTITY_PERSIST_FILE_VERSION << (quint32)entityProperties.size();
+
+    QScriptEngine scriptEngine;
+    foreach (const EntityItemProperties& properties, entityProperties) {
+        writeEntityPersistRecord(stream, scriptEngine, properties);
+    }
+
+    qint64 size = persistFile.pos();
+    if (stream.status() != QDataStream::Ok || !persistFile.commit()) {
+        qCritical() << "Could not write binary entities file" << fileName;
+        return false;
+    }
+
+    QMutexLocker locker(&_entitiesToPersistLock);
+    _binaryPersistFileSize = size;
+    _binaryPersistSnapshotRecords = entityProperties.size();
+    _binaryPersistLogRecords = 0;
+    return true;
+}
+
+bool EntityTree::appendToBinaryLog(const QString& fileName, const QVector<EntityItemProperties>& changedEntities,
+                                   const QVector<QUuid>& deletedEntityIDs) {
+    QFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCritical() << "Could not open binary entities file" << fileName << "for appending.";
+        return false;
+    }
+
+    QDataStream stream(&persistFile);
+    stream.setVersion(ENTITY_PERSIST_STREAM_VERSION);
+
+    // deletes first, an entity can not be deleted after its latest properties
+    foreach (const QUuid& id, deletedEntityIDs) {
+        stream << ENTITY_PERSIST_RECORD_DELETED << id;
+    }
+
+    QScriptEngine scriptEngine;
+    foreach (const EntityItemProperties& properties, changedEntities) {
+        writeEntityPersistRecord(stream, scriptEngine, properties);
+    }
+
+    persistFile.flush();
+    qint64 size = persistFile.size();
+    if (stream.status() != QDataStream::Ok || persistFile.error() != QFile::NoError) {
+        qCritical() << "Could not append to binary entities file" << fileName;
+        return false;
+    }
+
+    QMutexLocker locker(&_entitiesToPersistLock);
+    _binaryPersistFileSize = size;
+    _binaryPersistLogRecords += changedEntities.size() + deletedEntityIDs.size();
+    return true;
+}
+
+bool EntityTree::readFromBinaryFile(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        qCDebug(entities) << "unable to open binary entities file" << fileName;
+        return false;
+    }
+
+    uchar* data = file.map(0, file.size());
+    if (!data) {
+        qCDebug(entities) << "unable to map binary entities file" << fileName;
+        return false;
+    }
+
+    // read straight from the mapping, without copying the file
+    QByteArray fileData = QByteArray::fromRawData(reinterpret_cast<const char*>(data), (int)file.size());
+    QDataStream stream(fileData);
+    stream.setVersion(ENTITY_PERSIST_STREAM_VERSION);
+
+    char magic[ENTITY_PERSIST_FILE_MAGIC_SIZE];
+    quint32 version = 0;
+    quint32 numSnapshotRecords = 0;
+    if (stream.readRawData(magic, ENTITY_PERSIST_FILE_MAGIC_SIZE) != ENTITY_PERSIST_FILE_MAGIC_SIZE ||
+        memcmp(magic, ENTITY_PERSIST_FILE_MAGIC, ENTITY_PERSIST_FILE_MAGIC_SIZE) != 0) {
+        qCDebug(entities) << "not a binary entities file" << fileName;
+        file.unmap(data);
+        return false;
+    }
+    stream >> version >> numSnapshotRecords;
+    if (version != ENTITY_PERSIST_FILE_VERSION) {
+        qCDebug(entities) << "unsupported binary entities file version" << version << "in" << fileName;
+        file.unmap(data);
+        return false;
+    }
+
+    // fold the log into the snapshot, the latest record for each entity wins
+    QHash<QUuid, QVariant> entityVariants;
+    quint32 numRecords = 0;
+    qint64 validSize = stream.device()->pos();
+    while (!stream.atEnd()) {
+        quint8 recordType = 0;
+        stream >> recordType;
+
+        if (recordType == ENTITY_PERSIST_RECORD_PROPERTIES) {
+            QVariant entityVariant;
+            stream >> entityVariant;
+            if (stream.status() != QDataStream::Ok) {
+                break;
+            }
+            QUuid id = QUuid(entityVariant.toMap()["id"].toString());
+            if (id.isNull()) {
+                qCDebug(entities) << "skipping entity without an id in binary entities file" << fileName;
+            } else {
+                entityVariants[id] = entityVariant;
+            }
+        } else if (recordType == ENTITY_PERSIST_RECORD_DELETED) {
+            QUuid id;
+            stream >> id;
+            if (stream.status() != QDataStream::Ok) {
+                break;
+            }
+            entityVariants.remove(id);
+        } else {
+            break;
+        }
+
+        ++numRecords;
+        validSize = stream.device()->pos();
+    }
+
+    if (validSize != file.size()) {
+        // most likely a crash while appending, the complete records before it are still good
+        qCDebug(entities) << "ignoring truncated record at" << validSize << "in binary entities file" << fileName;
+    }
+
+    QVariantMap map;
+    map["Entities"] = QVariantList(entityVariants.values());
+    file.unmap(data);
+
+    bool success = entityVariants.isEmpty() || readFromMap(map);
+
+    {
+        // the file now matches the tree, so only the changes from here on need to be appended
+        QMutexLocker locker(&_entitiesToPersistLock);
+        _binaryPersistFileName = fileName;
+        _binaryPersistFileSize = validSize;
+        _binaryPersistSnapshotRecords = (int)std::min(numSnapshotRecords, numRecords);
+        _binaryPersistLogRecords = (int)numRecords - _binaryPersistSnapshotRecords;
+        _changedEntitiesToPersist.clear();
+        _deletedEntitiesToPersist.clear();
+    }
+    return success;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
@@ -12,6 +12,7 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -187,6 +188,15 @@ public:
 
     void forgetEntitiesDeletedBefore(quint64 sinceTime);
 
+    // marks the entity as changed on the server and notes it in the journal of recent changes
+    void markEntityChangedOnServer(EntityItemPointer entity);
+
+    /// Adds to the bag the elements to encode to send the entities changed since the given time, without traversing
+    /// the tree. Returns false if the changes aren't known that far back. Call with the tree read-locked.
+    bool addElementsChangedSinceToBag(quint64 sinceTime, OctreeElementBag& bag);
+
+    void forgetEntitiesChangedBefore(quint64 sinceTime);
+
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
 
@@ -226,6 +236,11 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
 
+    // binary persist file: a snapshot of all entities followed by a log of the changes since, compacted into a new
+    // snapshot once the log outgrows it
+    virtual bool writeToBinaryFile(const char* fileName) override;
+    virtual bool readFromBinaryFile(const QString& fileName) override;
+
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
 
@@ -307,6 +322,25 @@ protected:
     mutable QReadWriteLock _recentlyDeletedEntitiesLock; /// lock of server side recent deletes
     QMultiMap<quint64, QUuid> _recentlyDeletedEntityItemIDs; /// server side recent deletes
 
+    void trackChangedEntity(const QUuid& id);
+
+    mutable QReadWriteLock _recentlyChangedEntitiesLock; /// lock of server side recent changes
+    QMultiMap<quint64, QUuid> _recentlyChangedEntityItemIDs; /// server side recent changes
+    quint64 _recentlyChangedEntitiesSince { usecTimestampNow() }; /// server side recent changes are complete since
+
+    void trackEntityToPersist(const QUuid& id, bool isDeleted);
+    bool writeBinarySnapshot(const QString& fileName, const QVector<EntityItemProperties>& entityProperties);
+    bool appendToBinaryLog(const QString& fileName, const QVector<EntityItemProperties>& changedEntities,
+                           const QVector<QUuid>& deletedEntityIDs);
+
+    QMutex _entitiesToPersistLock; /// lock of the changes not yet in the binary persist file
+    QSet<QUuid> _changedEntitiesToPersist;
+    QSet<QUuid> _deletedEntitiesToPersist;
+    QString _binaryPersistFileName; /// changes are only tracked while persisting to this binary file
+    qint64 _binaryPersistFileSize { 0 };
+    int _binaryPersistSnapshotRecords { 0 };
+    int _binaryPersistLogRecords { 0 };
+
     mutable QReadWriteLock _deletedEntitiesLock; /// lock of client side recent deletes
     QSet<QUuid> _deletedEntityItemIDs; /// client side recent deletes
 
@@ -78,6 +78,7 @@ void EntityTreeElement::initializeExtraEncodeData(EncodeBitstreamParams& params)
     if (!extraEncodeData->contains(this)) {
         EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData { new EntityTreeElementExtraEncodeData() };
         entityTreeElementExtraEncodeData->elementCompleted = (_entityItems.size() == 0);
+        entityTreeElementExtraEncodeData->resetEntitiesToEncode(_entityItems.size(), _entityItemsVersion);
         for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
             EntityTreeElementPointer child = getChildAtIndex(i);
             if (!child) {
@@ -90,9 +91,6 @@ void EntityTreeElement::initializeExtraEncodeData(EncodeBitstreamParams& params)
                 }
             }
         }
-        forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
-        });
 
         // TODO: some of these inserts might be redundant!!!
         extraEncodeData->insert(this, entityTreeElementExtraEncodeData);
@@ -287,9 +285,6 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 }
             }
         }
-        forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
-        });
     }
 
     //assert(extraEncodeData);
@@ -310,6 +305,11 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
         // need to handle the case where our sibling elements need encoding but we don't.
         if (!entityTreeElementExtraEncodeData->elementCompleted) {
 
+            if (!hadElementExtraData || entityTreeElementExtraEncodeData->entityItemsVersion != _entityItemsVersion) {
+                // first pass for this element, or its entities were added or removed since the last pass in which case
+                // we no longer know which were encoded and encode them all again
+                entityTreeElementExtraEncodeData->resetEntitiesToEncode(_entityItems.size(), _entityItemsVersion);
+            }
 
             // we have an EntityNodeData instance
             // so we should assume that means we might have JSON filters to check
@@ -347,7 +347,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 }
 
                 if (includeThisEntity && hadElementExtraData) {
-                    includeThisEntity = entityTreeElementExtraEncodeData->entities.contains(entity->getEntityItemID());
+                    includeThisEntity = entityTreeElementExtraEncodeData->entitiesToEncode.testBit(i);
                 }
 
                 // we only check the bounds against our frustum and LOD if the query has asked us to check against the frustum
@@ -407,7 +407,8 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 } else {
                     // if the extra data included this entity, and we've decided to not include the entity, then
                     // we can treat it as if it was completed.
-                    entityTreeElementExtraEncodeData->entities.remove(entity->getEntityItemID());
+                    entityTreeElementExtraEncodeData->entitiesToEncode.clearBit(i);
+                    entityTreeElementExtraEncodeData->partialEntities.remove(entity->getEntityItemID());
                 }
             }
         }
@@ -435,7 +436,8 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
 
                 // If the entity item got completely appended, then we can remove it from the extra encode data
                 if (appendEntityState == OctreeElement::COMPLETED) {
-                    entityTreeElementExtraEncodeData->entities.remove(entity->getEntityItemID());
+                    entityTreeElementExtraEncodeData->entitiesToEncode.clearBit(i);
+                    entityTreeElementExtraEncodeData->partialEntities.remove(entity->getEntityItemID());
                 }
 
                 // If any part of the entity items didn't fit, then the element is considered partial
@@ -466,7 +468,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
         // since that will signal that the entire element needs to be encoded on the next attempt
         if (appendElementState == OctreeElement::NONE) {
 
-            if (!entityTreeElementExtraEncodeData->elementCompleted && entityTreeElementExtraEncodeData->entities.size() == 0) {
+            if (!entityTreeElementExtraEncodeData->elementCompleted && !entityTreeElementExtraEncodeData->hasEntitiesToEncode()) {
                 // TODO: we used to delete the extra encode data here. But changing the logic around
                 // this is now a dead code branch. Clean this up!
             } else {
@@ -478,7 +480,7 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
             // If we weren't previously completed, check to see if we are
             if (!entityTreeElementExtraEncodeData->elementCompleted) {
                 // If all of our items have been encoded, then we are complete as an element.
-                if (entityTreeElementExtraEncodeData->entities.size() == 0) {
+                if (!entityTreeElementExtraEncodeData->hasEntitiesToEncode()) {
                     entityTreeElementExtraEncodeData->elementCompleted = true;
                 }
             }
@@ -871,11 +873,9 @@ void EntityTreeElement::getEntities(const ViewFrustum& frustum, QVector<EntityIt
 EntityItemPointer EntityTreeElement::getEntityWithEntityItemID(const EntityItemID& id) const {
     EntityItemPointer foundEntity = NULL;
     withReadLock([&] {
-        foreach(EntityItemPointer entity, _entityItems) {
-            if (entity->getEntityItemID() == id) {
-                foundEntity = entity;
-                break;
-            }
+        auto it = _entityItemIndices.constFind(id);
+        if (it != _entityItemIndices.constEnd()) {
+            foundEntity = _entityItems[it.value()];
         }
     });
     return foundEntity;
@@ -891,32 +891,34 @@ void EntityTreeElement::cleanupEntities() {
             entity->_element = NULL;
         }
         _entityItems.clear();
+        _entityItemIndices.clear();
+        ++_entityItemsVersion;
     });
 }
 
 bool EntityTreeElement::removeEntityWithEntityItemID(const EntityItemID& id) {
     bool foundEntity = false;
     withWriteLock([&] {
-        uint16_t numberOfEntities = _entityItems.size();
-        for (uint16_t i = 0; i < numberOfEntities; i++) {
-            EntityItemPointer& entity = _entityItems[i];
-            if (entity->getEntityItemID() == id) {
-                foundEntity = true;
-                entity->_element = NULL;
-                _entityItems.removeAt(i);
-                break;
-            }
+        auto it = _entityItemIndices.find(id);
+        if (it != _entityItemIndices.end()) {
+            foundEntity = true;
+            _entityItems[it.value()]->_element = NULL;
+            removeEntityAtIndex(it.value());
         }
     });
     return foundEntity;
 }
 
 bool EntityTreeElement::removeEntityItem(EntityItemPointer entity) {
-    int numEntries = 0;
+    bool foundEntity = false;
     withWriteLock([&] {
-        numEntries = _entityItems.removeAll(entity);
+        auto it = _entityItemIndices.find(entity->getEntityItemID());
+        if (it != _entityItemIndices.end() && _entityItems[it.value()] == entity) {
+            foundEntity = true;
+            removeEntityAtIndex(it.value());
+        }
     });
-    if (numEntries > 0) {
+    if (foundEntity) {
         assert(entity->_element.get() == this);
         entity->_element = NULL;
         return true;
@@ -924,6 +926,18 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity) {
     return false;
 }
 
+void EntityTreeElement::removeEntityAtIndex(int index) {
+    // move the last entity into the removed one's place, so that removal doesn't shift the others
+    _entityItemIndices.remove(_entityItems[index]->getEntityItemID());
+    int lastIndex = _entityItems.size() - 1;
+    if (index != lastIndex) {
+        _entityItems[index] = _entityItems[lastIndex];
+        _entityItemIndices[_entityItems[index]->getEntityItemID()] = index;
+    }
+    _entityItems.removeLast();
+    ++_entityItemsVersion;
+}
+
 
 // Things we want to accomplish as we read these entities from the data buffer.
 //
@@ -1055,7 +1069,9 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     assert(entity);
     assert(entity->_element == nullptr);
     withWriteLock([&] {
+        _entityItemIndices.insert(entity->getEntityItemID(), _entityItems.size());
         _entityItems.push_back(entity);
+        ++_entityItemsVersion;
     });
     entity->_element = getThisPointer();
 }
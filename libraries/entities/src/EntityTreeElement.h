@@ -15,6 +15,8 @@
 #include <memory>
 
 #include <OctreeElement.h>
+#include <QBitArray>
+#include <QHash>
 #include <QList>
 
 #include "EntityEditPacketSender.h"
@@ -46,13 +48,28 @@ public:
     EntityTreeElementExtraEncodeData() :
         elementCompleted(false),
         subtreeCompleted(false),
-        entities() {
+        partialEntities() {
             memset(childCompleted, 0, sizeof(childCompleted));
         }
+
+    // marks all the entities of the element as still to be encoded
+    void resetEntitiesToEncode(int numberOfEntities, quint32 version) {
+        entitiesToEncode.fill(true, numberOfEntities);
+        entityItemsVersion = version;
+    }
+    bool hasEntitiesToEncode() const { return entitiesToEncode.count(true) > 0; }
+
     bool elementCompleted;
     bool subtreeCompleted;
     bool childCompleted[NUMBER_OF_CHILDREN];
-    QMap<EntityItemID, EntityPropertyFlags> entities;
+
+    // the entities of the element still to be encoded, by their index in the element,
+    // for the version of the element's entities given by entityItemsVersion
+    QBitArray entitiesToEncode;
+    quint32 entityItemsVersion { 0 };
+
+    // the properties still to be encoded of the entities that only partially fit
+    QHash<EntityItemID, EntityPropertyFlags> partialEntities;
 };
 using EntityTreeElementExtraEncodeDataPointer = std::shared_ptr<EntityTreeElementExtraEncodeData>;
 
@@ -64,7 +81,8 @@ inline QDebug operator<<(QDebug debug, const EntityTreeElementExtraEncodeDataPoi
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
         debug << " " << i << ":" << data->childCompleted[i] << ", ";
     }
-    debug << " entities.size: " << data->entities.size() << "}";
+    debug << " entitiesToEncode: " << data->entitiesToEncode.count(true) << ", ";
+    debug << " partialEntities.size: " << data->partialEntities.size() << "}";
     return debug;
 }
 
@@ -240,8 +258,14 @@ public:
 
 protected:
     virtual void init(unsigned char * octalCode) override;
+
+    // requires the write lock
+    void removeEntityAtIndex(int index);
+
     EntityTreePointer _myTree;
     EntityItems _entityItems;
+    QHash<EntityItemID, int> _entityItemIndices; // index of each entity in _entityItems
+    quint32 _entityItemsVersion { 0 }; // bumped whenever the indices of _entityItems change
 };
 
 #endif // hifi_EntityTreeElement_h
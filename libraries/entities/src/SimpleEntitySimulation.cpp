@@ -41,7 +41,7 @@ void SimpleEntitySimulation::clearOwnership(const QUuid& ownerID) {
 
             // remove ownership and dirty all the tree elements that contain the it
             entity->clearSimulationOwnership();
-            entity->markAsChangedOnServer();
+            getEntityTree()->markEntityChangedOnServer(entity);
             DirtyOctreeElementOperator op(entity->getElement());
             getEntityTree()->recurseTreeWithOperator(&op);
         } else {
@@ -70,7 +70,7 @@ void SimpleEntitySimulation::updateEntitiesInternal(const quint64& now) {
                     entity->setAcceleration(Vectors::ZERO);
 
                     // dirty all the tree elements that contain it
-                    entity->markAsChangedOnServer();
+                    getEntityTree()->markEntityChangedOnServer(entity);
                     DirtyOctreeElementOperator op(entity->getElement());
                     getEntityTree()->recurseTreeWithOperator(&op);
                 }
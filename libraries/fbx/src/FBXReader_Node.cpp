@@ -11,192 +11,185 @@
 
 #include "FBXReader.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <zlib.h>
+
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 #include <QtCore/QDebug>
-#include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
 #include <shared/NsightHelpers.h>
 #include "ModelFormatLogging.h"
 
-template<class T> int streamSize() {
-    return sizeof(T);
-}
+// The binary FBX is parsed in place, from the bytes of the whole file
+class BinaryFBXStream {
+public:
+    BinaryFBXStream(const char* begin, const char* end) : _begin(begin), _position(begin), _end(end) {}
 
-template<bool> int streamSize() {
-    return 1;
-}
+    qint64 getOffset() const { return _position - _begin; }
+
+    // Returns the next bytes and moves past them
+    const char* take(quint64 size) {
+        if ((quint64)(_end - _position) < size) {
+            throw QString("truncated fbx file");
+        }
+        const char* result = _position;
+        _position += size;
+        return result;
+    }
 
-template<class T> QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
-
-    in >> arrayLength;
-    in >> encoding;
-    in >> compressedLength;
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        const unsigned int DEFLATE_ENCODING = 1;
-        QByteArray arrayData;
-        if (encoding == DEFLATE_ENCODING) {
-            // preface encoded data with uncompressed length
-            QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
+    template<class T> T read() {
+        T value;
+        memcpy(&value, take(sizeof(T)), sizeof(T));
+        swapFromLittleEndian(&value, 1);
+        return value;
+    }
+
+    template<class T> static void swapFromLittleEndian(T* values, quint32 count) {
+        if (QSysInfo::ByteOrder == QSysInfo::BigEndian && sizeof(T) > 1) {
+            for (quint32 i = 0; i < count; i++) {
+                char* bytes = reinterpret_cast<char*>(&values[i]);
+                std::reverse(bytes, bytes + sizeof(T));
             }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
         }
+    }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
+private:
+    const char* _begin;
+    const char* _position;
+    const char* _end;
+};
+
+// Inflates in a single pass, straight into the storage of the array
+static bool inflateBinaryArray(const char* compressed, quint32 compressedLength, void* destination, quint32 length) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    stream.next_in = (Bytef*)compressed;
+    stream.avail_in = compressedLength;
+    stream.next_out = (Bytef*)destination;
+    stream.avail_out = length;
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    int status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return status == Z_STREAM_END && stream.avail_out == 0;
+}
+
+template<class T> QVector<T> readBinaryArrayValues(BinaryFBXStream& in) {
+    quint32 arrayLength = in.read<quint32>();
+    quint32 encoding = in.read<quint32>();
+    quint32 compressedLength = in.read<quint32>();
+
+    const quint64 length = (quint64)sizeof(T) * arrayLength;
+    if (length > (quint64)std::numeric_limits<int>::max()) {
+        throw QString("corrupt fbx file");
+    }
+    const unsigned int DEFLATE_ENCODING = 1;
+    if (encoding == DEFLATE_ENCODING) {
+        const char* compressed = in.take(compressedLength);
+        // a corrupt array could claim any length, but deflate compresses to at most about 1/1000th
+        const quint64 MAX_DEFLATE_RATIO = 1032;
+        if (length > (quint64)compressedLength * MAX_DEFLATE_RATIO) {
+            throw QString("corrupt fbx file");
         }
-    } else {
-        values.reserve(arrayLength);
-        const unsigned int DEFLATE_ENCODING = 1;
-        if (encoding == DEFLATE_ENCODING) {
-            // preface encoded data with uncompressed length
-            QByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            QByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+        QVector<T> values(arrayLength);
+        if (length > 0 && !inflateBinaryArray(compressed, compressedLength, values.data(), (quint32)length)) {
+            throw QString("corrupt fbx file");
         }
+        BinaryFBXStream::swapFromLittleEndian(values.data(), arrayLength);
+        return values;
     }
+
+    const char* data = in.take(length);
+    QVector<T> values(arrayLength);
+    if (length > 0) {
+        memcpy(values.data(), data, length);
+    }
+    BinaryFBXStream::swapFromLittleEndian(values.data(), arrayLength);
+    return values;
+}
+
+template<class T> QVariant readBinaryArray(BinaryFBXStream& in) {
+    return QVariant::fromValue(readBinaryArrayValues<T>(in));
+}
+
+// the bytes of a bool array are not guaranteed to be 0 or 1, so they are read as bytes rather than copied into bools
+template<> QVariant readBinaryArray<bool>(BinaryFBXStream& in) {
+    QVector<quint8> bytes = readBinaryArrayValues<quint8>(in);
+    QVector<bool> values(bytes.size());
+    std::transform(bytes.cbegin(), bytes.cend(), values.begin(), [](quint8 byte) { return byte != 0; });
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+QVariant parseBinaryFBXProperty(BinaryFBXStream& in) {
+    char ch = in.read<char>();
     switch (ch) {
         case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint16>());
         }
         case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint8>() != 0);
         }
         case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint32>());
         }
         case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<float>());
         }
         case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<double>());
         }
         case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint64>());
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(in);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(in);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(in);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(in);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(in);
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = in.read<quint32>();
+            return QVariant::fromValue(QByteArray(in.take(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(BinaryFBXStream& in, bool has64BitPositions = false) {
     qint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
     // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
+    // from here on out, but if the file is an older format we read the 32bit values and widen them.
     if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+        endOffset = in.read<qint64>();
+        propertyCount = in.read<quint64>();
+        in.read<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = in.read<qint32>();
+        propertyCount = in.read<quint32>();
+        in.read<quint32>(); // property list length
+    }
+    quint8 nameLength = in.read<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -204,15 +197,14 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = QByteArray(in.take(nameLength), nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(in));
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > in.getOffset()) {
+        FBXNode child = parseBinaryFBXNode(in, has64BitPositions);
         if (child.name.isNull()) {
             return node;
 
@@ -366,9 +358,20 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+
+    // The models are downloaded or read to memory before parsing, so a buffer device gives the bytes directly
+    // rather than through a copy. The arrays are then inflated or copied once, into the vectors of the nodes.
+    QByteArray contents;
+    auto buffer = qobject_cast<QBuffer*>(device);
+    if (buffer) {
+        contents = buffer->data();
+        if (buffer->pos() > 0) {
+            contents = QByteArray::fromRawData(contents.constData() + buffer->pos(), contents.size() - (int)buffer->pos());
+        }
+    } else {
+        contents = device->readAll();
+    }
+    BinaryFBXStream in(contents.constData(), contents.constData() + contents.size());
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -379,18 +382,15 @@ FBXNode FBXReader::parseFBX(QIODevice* device) {
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
     const int HEADER_BEFORE_VERSION = 23;
     const quint32 VERSION_FBX2016 = 7500;
-    in.skipRawData(HEADER_BEFORE_VERSION);
-    int position = HEADER_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
+    in.take(HEADER_BEFORE_VERSION);
+    quint32 fileVersion = in.read<quint32>();
     qCDebug(modelformat) << "fileVersion:" << fileVersion;
     bool has64BitPositions = (fileVersion >= VERSION_FBX2016);
 
     // parse the top-level node
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (in.getOffset() < contents.size()) {
+        FBXNode next = parseBinaryFBXNode(in, has64BitPositions);
         if (next.name.isNull()) {
             return top;
 
@@ -410,6 +410,7 @@ glm::vec3 FBXReader::getVec3(const QVariantList& properties, int index) {
 
 QVector<glm::vec4> FBXReader::createVec4Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -423,6 +424,7 @@ QVector<glm::vec4> FBXReader::createVec4Vector(const QVector<double>& doubleVect
 
 QVector<glm::vec4> FBXReader::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -440,6 +442,7 @@ QVector<glm::vec4> FBXReader::createVec4VectorRGBA(const QVector<double>& double
 
 QVector<glm::vec3> FBXReader::createVec3Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec3> values;
+    values.reserve(doubleVector.size() / 3);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -451,6 +454,7 @@ QVector<glm::vec3> FBXReader::createVec3Vector(const QVector<double>& doubleVect
 
 QVector<glm::vec2> FBXReader::createVec2Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec2> values;
+    values.reserve(doubleVector.size() / 2);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
         float s = *it++;
         float t = *it++;
@@ -79,6 +79,9 @@ GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
                 case gpu::COMPRESSED_R:
                     result = GL_COMPRESSED_RED_RGTC1;
                     break;
+                case gpu::COMPRESSED_BC4_RED:
+                    result = GL_COMPRESSED_RED_RGTC1;
+                    break;
 
                 case gpu::R11G11B10:
                     // the type should be float
@@ -224,15 +227,15 @@ GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
                     result = GL_COMPRESSED_SRGB_ALPHA;
                     break;
 
-                    // FIXME: WE will want to support this later
-                    /*
-                    case gpu::COMPRESSED_BC3_RGBA:
-                    result = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                case gpu::COMPRESSED_BC1_SRGB:
+                    result = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
                     break;
-                    case gpu::COMPRESSED_BC3_SRGBA:
+                case gpu::COMPRESSED_BC3_SRGBA:
                     result = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
                     break;
 
+                    // FIXME: WE will want to support this later
+                    /*
                     case gpu::COMPRESSED_BC7_RGBA:
                     result = GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
                     break;
@@ -407,6 +410,10 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
                 texel.internalFormat = GL_COMPRESSED_RED_RGTC1;
                 break;
             }
+            case gpu::COMPRESSED_BC4_RED: {
+                texel.internalFormat = GL_COMPRESSED_RED_RGTC1;
+                break;
+            }
             case gpu::RED:
             case gpu::RGB:
             case gpu::RGBA:
@@ -652,6 +659,12 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
             case gpu::COMPRESSED_SRGBA:
                 texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA;
                 break;
+            case gpu::COMPRESSED_BC1_SRGB:
+                texel.internalFormat = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+                break;
+            case gpu::COMPRESSED_BC3_SRGBA:
+                texel.internalFormat = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+                break;
             default:
                 qCWarning(gpugllogging) << "Unknown combination of texel format";
             }
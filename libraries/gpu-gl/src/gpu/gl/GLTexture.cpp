@@ -10,6 +10,7 @@
 
 #include <QtCore/QThread>
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 #include "GLBackend.h"
 
@@ -170,6 +171,8 @@ using TransferJob = GLVariableAllocationSupport::TransferJob;
 
 const uvec3 GLVariableAllocationSupport::MAX_TRANSFER_DIMENSIONS { 1024, 1024, 1 };
 const size_t GLVariableAllocationSupport::MAX_TRANSFER_SIZE = GLVariableAllocationSupport::MAX_TRANSFER_DIMENSIONS.x * GLVariableAllocationSupport::MAX_TRANSFER_DIMENSIONS.y * 4;
+const size_t GLVariableAllocationSupport::MAX_TRANSFER_SIZE_PER_FRAME = GLVariableAllocationSupport::MAX_TRANSFER_SIZE;
+const uint64_t GLVariableAllocationSupport::MAX_TRANSFER_USECS_PER_FRAME = 2 * USECS_PER_MSEC;
 
 #if THREADED_TEXTURE_BUFFERING
 std::shared_ptr<std::thread> TransferJob::_bufferThread { nullptr };
@@ -221,10 +224,13 @@ TransferJob::TransferJob(const GLTexture& parent, uint16_t sourceMip, uint16_t t
 
     } else {
         transferDimensions.y = lines;
+        // the lines of block compressed mips are rows of 4x4 blocks, the line offset is a multiple of 4
+        const auto& texelFormat = _parent._gpuObject.getTexelFormat();
+        Q_ASSERT(0 == (lineOffset % Texture::evalTexelLinesPerLine(texelFormat)));
         auto dimensions = _parent._gpuObject.evalMipDimensions(sourceMip);
-        auto bytesPerLine = (uint32_t)mipSize / dimensions.y;
-        auto sourceOffset = bytesPerLine * lineOffset;
-        _transferSize = bytesPerLine * lines;
+        auto bytesPerLine = (uint32_t)mipSize / Texture::evalNumLines(dimensions.y, texelFormat);
+        auto sourceOffset = bytesPerLine * Texture::evalNumLines(lineOffset, texelFormat);
+        _transferSize = bytesPerLine * Texture::evalNumLines(lines, texelFormat);
         _bufferingLambda = [=] {
             auto mipData = _parent._gpuObject.accessStoredMipFace(sourceMip, face);
             _buffer.resize(_transferSize);
@@ -489,12 +495,18 @@ void GLVariableAllocationSupport::updateMemoryPressure() {
 
 void GLVariableAllocationSupport::processWorkQueues() {
     if (MemoryPressureState::Idle == _memoryPressureState) {
+        Backend::setTextureFrameTransferStats(0, 0);
         return;
     }
 
     auto& workQueue = getActiveWorkQueue();
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
-    while (!workQueue.empty()) {
+    // A single promotion or demotion per frame, but transfers continue across textures, smallest mips first,
+    // until the frame budget is spent. The first transfer always goes through so that large mips still progress.
+    const uint64_t startTime = usecTimestampNow();
+    size_t frameTransferSize = 0;
+    bool withinBudget = true;
+    while (withinBudget && !workQueue.empty()) {
         auto workTarget = workQueue.top();
         workQueue.pop();
         auto texture = workTarget.first.lock();
@@ -511,26 +523,31 @@ void GLVariableAllocationSupport::processWorkQueues() {
             }
             vartexture->demote();
             _memoryPressureStateStale = true;
+            withinBudget = false;
         } else if (MemoryPressureState::Undersubscribed == _memoryPressureState) {
             if (!vartexture->canPromote()) {
                 continue;
             }
             vartexture->promote();
             _memoryPressureStateStale = true;
+            withinBudget = false;
         } else if (MemoryPressureState::Transfer == _memoryPressureState) {
             if (!vartexture->hasPendingTransfers()) {
                 continue;
             }
-            vartexture->executeNextTransfer(texture);
+            bool transferred = vartexture->executeNextTransfer(texture, frameTransferSize);
+            withinBudget = transferred && frameTransferSize < MAX_TRANSFER_SIZE_PER_FRAME &&
+                (usecTimestampNow() - startTime) < MAX_TRANSFER_USECS_PER_FRAME;
         } else {
             Q_UNREACHABLE();
         }
 
         // Reinject into the queue if more work to be done
         addToWorkQueue(texture);
-        break;
     }
 
+    Backend::setTextureFrameTransferStats(frameTransferSize, usecTimestampNow() - startTime);
+
     if (workQueue.empty()) {
         _memoryPressureStateStale = true;
     }
@@ -543,9 +560,9 @@ void GLVariableAllocationSupport::manageMemory() {
 }
 
 
-void GLVariableAllocationSupport::executeNextTransfer(const TexturePointer& currentTexture) {
+bool GLVariableAllocationSupport::executeNextTransfer(const TexturePointer& currentTexture, size_t& transferSize) {
     if (_populatedMip <= _allocatedMip) {
-        return;
+        return true;
     }
 
     if (_pendingTransfers.empty()) {
@@ -555,9 +572,12 @@ void GLVariableAllocationSupport::executeNextTransfer(const TexturePointer& curr
     if (!_pendingTransfers.empty()) {
         // Keeping hold of a strong pointer during the transfer ensures that the transfer thread cannot try to access a destroyed texture
         _currentTransferTexture = currentTexture;
-        if (_pendingTransfers.front()->tryTransfer()) {
-            _pendingTransfers.pop();
-            _currentTransferTexture.reset();
+        if (!_pendingTransfers.front()->tryTransfer()) {
+            return false;
         }
+        transferSize += _pendingTransfers.front()->getTransferSize();
+        _pendingTransfers.pop();
+        _currentTransferTexture.reset();
     }
+    return true;
 }
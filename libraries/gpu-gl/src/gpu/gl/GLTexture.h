@@ -71,6 +71,7 @@ public:
         TransferJob(const GLTexture& parent, uint16_t sourceMip, uint16_t targetMip, uint8_t face, uint32_t lines = 0, uint32_t lineOffset = 0);
         ~TransferJob();
         bool tryTransfer();
+        size_t getTransferSize() const { return _transferSize; }
 
 #if THREADED_TEXTURE_BUFFERING
         static void startTransferLoop();
@@ -102,6 +103,10 @@ protected:
     static const uvec3 INITIAL_MIP_TRANSFER_DIMENSIONS;
     static const uvec3 MAX_TRANSFER_DIMENSIONS;
     static const size_t MAX_TRANSFER_SIZE;
+    // The transfers of all the textures share these budgets every frame, so that many textures becoming
+    // visible at once are streamed in over several frames rather than stalling one
+    static const size_t MAX_TRANSFER_SIZE_PER_FRAME;
+    static const uint64_t MAX_TRANSFER_USECS_PER_FRAME;
 
 
     static void updateMemoryPressure();
@@ -115,7 +120,8 @@ protected:
     bool canPromote() const { return _allocatedMip > 0; }
     bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
     bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
-    void executeNextTransfer(const TexturePointer& currentTexture);
+    // Returns false if the next transfer is still buffering, adds the size of the completed transfer to transferSize
+    bool executeNextTransfer(const TexturePointer& currentTexture, size_t& transferSize);
     virtual void populateTransferQueue() = 0;
     virtual void promote() = 0;
     virtual void demote() = 0;
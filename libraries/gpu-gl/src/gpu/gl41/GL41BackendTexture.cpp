@@ -96,7 +96,13 @@ void GL41Texture::generateMips() const {
 }
 
 void GL41Texture::copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, const void* sourcePointer) const {
-    if (GL_TEXTURE_2D == _target) {
+    const auto& texelFormat = _gpuObject.getTexelFormat();
+    if (texelFormat.isBlockCompressed()) {
+        GLenum internalFormat = GLTexelFormat::evalGLTexelFormatInternal(texelFormat);
+        GLsizei imageSize = (GLsizei)(Texture::evalLineSize(size.x, texelFormat) * Texture::evalNumLines(size.y, texelFormat));
+        GLenum target = (GL_TEXTURE_CUBE_MAP == _target) ? GLTexture::CUBE_FACE_LAYOUT[face] : _target;
+        glCompressedTexSubImage2D(target, mip, 0, yOffset, size.x, size.y, internalFormat, imageSize, sourcePointer);
+    } else if (GL_TEXTURE_2D == _target) {
         glTexSubImage2D(_target, mip, 0, yOffset, size.x, size.y, format, type, sourcePointer);
     } else if (GL_TEXTURE_CUBE_MAP == _target) {
         auto target = GLTexture::CUBE_FACE_LAYOUT[face];
@@ -290,6 +296,13 @@ void GL41VariableAllocationTexture::promote() {
             auto mipDimensions = _gpuObject.evalMipDimensions(mip);
             uint16_t targetMip = mip - _allocatedMip;
             uint16_t sourceMip = mip - oldAllocatedMip;
+            if (_gpuObject.getTexelFormat().isBlockCompressed()) {
+                // compressed mips cannot be read back through the framebuffer, upload them again as stored
+                for (uint8_t face = 0; face < getFaceCount(_target); ++face) {
+                    copyMipFaceFromTexture(mip, targetMip, face);
+                }
+                continue;
+            }
             for (GLenum target : getFaceTargets(_target)) {
                 glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, oldId, sourceMip);
                 (void)CHECK_GL_ERROR();
@@ -333,6 +346,13 @@ void GL41VariableAllocationTexture::demote() {
             auto mipDimensions = _gpuObject.evalMipDimensions(mip);
             uint16_t targetMip = mip - _allocatedMip;
             uint16_t sourceMip = mip - oldAllocatedMip;
+            if (_gpuObject.getTexelFormat().isBlockCompressed()) {
+                // compressed mips cannot be read back through the framebuffer, upload them again as stored
+                for (uint8_t face = 0; face < getFaceCount(_target); ++face) {
+                    copyMipFaceFromTexture(mip, targetMip, face);
+                }
+                continue;
+            }
             for (GLenum target : getFaceTargets(_target)) {
                 glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, oldId, sourceMip);
                 (void)CHECK_GL_ERROR();
@@ -384,11 +404,14 @@ void GL41VariableAllocationTexture::populateTransferQueue() {
 
             // break down the transfers into chunks so that no single transfer is 
             // consuming more than X bandwidth
+            // Block compressed mips are stored by rows of 4x4 blocks, so their chunks are whole rows of blocks
+            const auto& texelFormat = _gpuObject.getTexelFormat();
             auto mipSize = _gpuObject.getStoredMipFaceSize(sourceMip, face);
             const auto lines = mipDimensions.y;
-            auto bytesPerLine = mipSize / lines;
-            Q_ASSERT(0 == (mipSize % lines));
-            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine);
+            const auto storedLines = Texture::evalNumLines(lines, texelFormat);
+            auto bytesPerLine = mipSize / storedLines;
+            Q_ASSERT(0 == (mipSize % storedLines));
+            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine) * Texture::evalTexelLinesPerLine(texelFormat);
             uint32_t lineOffset = 0;
             while (lineOffset < lines) {
                 uint32_t linesToCopy = std::min<uint32_t>(lines - lineOffset, linesPerTransfer);
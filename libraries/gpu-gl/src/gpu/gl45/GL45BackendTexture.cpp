@@ -118,7 +118,23 @@ void GL45Texture::generateMips() const {
 }
 
 void GL45Texture::copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum format, GLenum type, const void* sourcePointer) const {
-    if (GL_TEXTURE_2D == _target) {
+    const auto& texelFormat = _gpuObject.getTexelFormat();
+    if (texelFormat.isBlockCompressed()) {
+        GLenum internalFormat = GLTexelFormat::evalGLTexelFormatInternal(texelFormat);
+        GLsizei imageSize = (GLsizei)(Texture::evalLineSize(size.x, texelFormat) * Texture::evalNumLines(size.y, texelFormat));
+        if (GL_TEXTURE_2D == _target) {
+            glCompressedTextureSubImage2D(_id, mip, 0, yOffset, size.x, size.y, internalFormat, imageSize, sourcePointer);
+        } else if (GL_TEXTURE_CUBE_MAP == _target) {
+            if (glCompressedTextureSubImage2DEXT) {
+                auto target = GLTexture::CUBE_FACE_LAYOUT[face];
+                glCompressedTextureSubImage2DEXT(_id, target, mip, 0, yOffset, size.x, size.y, internalFormat, imageSize, sourcePointer);
+            } else {
+                glCompressedTextureSubImage3D(_id, mip, 0, yOffset, face, size.x, size.y, 1, internalFormat, imageSize, sourcePointer);
+            }
+        } else {
+            Q_ASSERT(false);
+        }
+    } else if (GL_TEXTURE_2D == _target) {
         glTextureSubImage2D(_id, mip, 0, yOffset, size.x, size.y, format, type, sourcePointer);
     } else if (GL_TEXTURE_CUBE_MAP == _target) {
         // DSA ARB does not work on AMD, so use EXT
@@ -184,11 +184,14 @@ void GL45ResourceTexture::populateTransferQueue() {
 
             // break down the transfers into chunks so that no single transfer is 
             // consuming more than X bandwidth
+            // Block compressed mips are stored by rows of 4x4 blocks, so their chunks are whole rows of blocks
+            const auto& texelFormat = _gpuObject.getTexelFormat();
             auto mipSize = _gpuObject.getStoredMipFaceSize(sourceMip, face);
             const auto lines = mipDimensions.y;
-            auto bytesPerLine = mipSize / lines;
-            Q_ASSERT(0 == (mipSize % lines));
-            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine);
+            const auto storedLines = Texture::evalNumLines(lines, texelFormat);
+            auto bytesPerLine = mipSize / storedLines;
+            Q_ASSERT(0 == (mipSize % storedLines));
+            uint32_t linesPerTransfer = (uint32_t)(MAX_TRANSFER_SIZE / bytesPerLine) * Texture::evalTexelLinesPerLine(texelFormat);
             uint32_t lineOffset = 0;
             while (lineOffset < lines) {
                 uint32_t linesToCopy = std::min<uint32_t>(lines - lineOffset, linesPerTransfer);
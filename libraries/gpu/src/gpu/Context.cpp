@@ -247,6 +247,8 @@ std::atomic<Texture::Size> Context::_textureGPUVirtualMemoryUsage { 0 };
 std::atomic<Texture::Size> Context::_textureGPUFramebufferMemoryUsage { 0 };
 std::atomic<Texture::Size> Context::_textureGPUSparseMemoryUsage { 0 };
 std::atomic<uint32_t> Context::_textureGPUTransferCount { 0 };
+std::atomic<Texture::Size> Context::_textureFrameTransferSize { 0 };
+std::atomic<uint64_t> Context::_textureFrameTransferUsecs { 0 };
 
 void Context::setFreeGPUMemory(Size size) {
     _freeGPUMemory.store(size);
@@ -386,6 +388,11 @@ void Context::decrementTextureGPUTransferCount() {
     --_textureGPUTransferCount;
 }
 
+void Context::setTextureFrameTransferStats(Size transferSize, uint64_t transferUsecs) {
+    _textureFrameTransferSize.store(transferSize);
+    _textureFrameTransferUsecs.store(transferUsecs);
+}
+
 uint32_t Context::getBufferGPUCount() {
     return _bufferGPUCount.load();
 }
@@ -426,6 +433,14 @@ uint32_t Context::getTextureGPUTransferCount() {
     return _textureGPUTransferCount.load();
 }
 
+Context::Size Context::getTextureFrameTransferSize() {
+    return _textureFrameTransferSize.load();
+}
+
+uint64_t Context::getTextureFrameTransferUsecs() {
+    return _textureFrameTransferUsecs.load();
+}
+
 void Backend::setFreeGPUMemory(Size size) { Context::setFreeGPUMemory(size); }
 Resource::Size Backend::getFreeGPUMemory() { return Context::getFreeGPUMemory(); }
 void Backend::incrementBufferGPUCount() { Context::incrementBufferGPUCount(); }
@@ -442,5 +457,6 @@ void Backend::updateTextureGPUFramebufferMemoryUsage(Resource::Size prevObjectSi
 void Backend::updateTextureGPUSparseMemoryUsage(Resource::Size prevObjectSize, Resource::Size newObjectSize) { Context::updateTextureGPUSparseMemoryUsage(prevObjectSize, newObjectSize); }
 void Backend::incrementTextureGPUTransferCount() { Context::incrementTextureGPUTransferCount(); }
 void Backend::decrementTextureGPUTransferCount() { Context::decrementTextureGPUTransferCount(); }
+void Backend::setTextureFrameTransferStats(Resource::Size transferSize, uint64_t transferUsecs) { Context::setTextureFrameTransferStats(transferSize, transferUsecs); }
 
 
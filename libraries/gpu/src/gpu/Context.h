@@ -108,6 +108,7 @@ public:
     static void updateTextureGPUFramebufferMemoryUsage(Resource::Size prevObjectSize, Resource::Size newObjectSize);
     static void incrementTextureGPUTransferCount();
     static void decrementTextureGPUTransferCount();
+    static void setTextureFrameTransferStats(Resource::Size transferSize, uint64_t transferUsecs);
 
 protected:
     virtual bool isStereo() {
@@ -227,6 +228,9 @@ public:
     static Size getTextureGPUFramebufferMemoryUsage();
     static Size getTextureGPUSparseMemoryUsage();
     static uint32_t getTextureGPUTransferCount();
+    // The texture data transferred by the backend during the last frame, and the time spent on it
+    static Size getTextureFrameTransferSize();
+    static uint64_t getTextureFrameTransferUsecs();
 
 protected:
     Context(const Context& context);
@@ -272,6 +276,7 @@ protected:
     static void updateTextureGPUFramebufferMemoryUsage(Size prevObjectSize, Size newObjectSize);
     static void incrementTextureGPUTransferCount();
     static void decrementTextureGPUTransferCount();
+    static void setTextureFrameTransferStats(Size transferSize, uint64_t transferUsecs);
 
     // Buffer, Texture and Fence Counters
     static std::atomic<Size> _freeGPUMemory;
@@ -288,6 +293,8 @@ protected:
     static std::atomic<Size> _textureGPUVirtualMemoryUsage;
     static std::atomic<Size> _textureGPUFramebufferMemoryUsage;
     static std::atomic<uint32_t> _textureGPUTransferCount;
+    static std::atomic<Size> _textureFrameTransferSize;
+    static std::atomic<uint64_t> _textureFrameTransferUsecs;
 
     friend class Backend;
 };
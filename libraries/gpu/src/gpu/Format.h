@@ -165,12 +165,13 @@ enum Semantic {
     COMPRESSED_SRGB,
     COMPRESSED_SRGBA,
 
-    // FIXME: Will have to be supported later:
-    /*COMPRESSED_BC3_RGBA,  // RGBA_S3TC_DXT5_EXT,
+    // These are block compression formats, the texels are stored by blocks of 4x4
+    // already compressed on the cpu, so they can be cached and uploaded as is
+    _FIRST_BLOCK_COMPRESSED,
+    COMPRESSED_BC1_SRGB,  // SRGB_S3TC_DXT1_EXT
     COMPRESSED_BC3_SRGBA, // SRGB_ALPHA_S3TC_DXT5_EXT
-
-    COMPRESSED_BC7_RGBA,
-    COMPRESSED_BC7_SRGBA, */
+    COMPRESSED_BC4_RED,   // RED_RGTC1
+    _LAST_BLOCK_COMPRESSED,
 
     _LAST_COMPRESSED,
 
@@ -207,6 +208,10 @@ public:
     Dimension getDimension() const { return (Dimension)_dimension; }
     
     bool isCompressed() const { return uint8(getSemantic() - _FIRST_COMPRESSED) <= uint8(_LAST_COMPRESSED - _FIRST_COMPRESSED); }
+    bool isBlockCompressed() const { return uint8(getSemantic() - _FIRST_BLOCK_COMPRESSED) <= uint8(_LAST_BLOCK_COMPRESSED - _FIRST_BLOCK_COMPRESSED); }
+
+    // Size in bytes of a 4x4 texel block of a block compressed format
+    uint32 getBlockSize() const { return (getSemantic() == COMPRESSED_BC3_SRGBA) ? 16 : 8; }
 
     Type getType() const { return (Type)_type; }
     bool isNormalized() const { return (getType() >= NORMALIZED_START); }
@@ -236,6 +241,9 @@ public:
     static const Element COLOR_BGRA_32;
     static const Element COLOR_SBGRA_32;
     static const Element COLOR_R11G11B10;
+    static const Element COLOR_COMPRESSED_SRGB;
+    static const Element COLOR_COMPRESSED_SRGBA;
+    static const Element COLOR_COMPRESSED_RED;
     static const Element VEC4F_COLOR_RGBA;
     static const Element VEC2F_UV;
     static const Element VEC2F_XY;
@@ -114,6 +114,14 @@ uint32_t Texture::getTextureGPUTransferCount() {
     return Context::getTextureGPUTransferCount();
 }
 
+Texture::Size Texture::getTextureFrameTransferSize() {
+    return Context::getTextureFrameTransferSize();
+}
+
+uint64_t Texture::getTextureFrameTransferUsecs() {
+    return Context::getTextureFrameTransferUsecs();
+}
+
 Texture::Size Texture::getAllowedGPUMemoryUsage() {
     return _allowedCPUMemoryUsage;
 }
@@ -330,7 +338,7 @@ Texture::Size Texture::resize(Type type, const Element& texelFormat, uint16 widt
         }
 
         // Evaluate the new size with the new format
-        Size size = NUM_FACES_PER_TYPE[_type] * _height * _depth * evalPaddedSize(_numSamples * _width * _texelFormat.getSize());
+        Size size = NUM_FACES_PER_TYPE[_type] * evalNumLines(_height, _texelFormat) * _depth * evalLineSize(_numSamples * _width, _texelFormat);
 
         // If size change then we need to reset 
         if (changed || (size != getSize())) {
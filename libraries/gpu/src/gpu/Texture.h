@@ -13,6 +13,7 @@
 
 #include <algorithm> //min max and more
 #include <bitset>
+#include <mutex>
 
 #include <QMetaType>
 #include <QUrl>
@@ -176,6 +177,8 @@ public:
     static Size getTextureGPUFramebufferMemoryUsage();
     static Size getTextureGPUSparseMemoryUsage();
     static uint32_t getTextureGPUTransferCount();
+    static Size getTextureFrameTransferSize();
+    static uint64_t getTextureFrameTransferUsecs();
     static Size getAllowedGPUMemoryUsage();
     static void setAllowedGPUMemoryUsage(Size size);
 
@@ -321,8 +324,14 @@ public:
         void reset() override { }
 
     protected:
+        // Maps the file, or shares the mapping still held by the mips in use
+        storage::StoragePointer mapFile() const;
+
         std::string _filename;
         ktx::KTXDescriptorPointer _ktxDescriptor;
+        // The mapping is released with the last mip view, an idle texture does not keep its file open
+        mutable std::mutex _fileMutex;
+        mutable std::weak_ptr<const storage::Storage> _file;
         friend class Texture;
     };
 
@@ -413,12 +422,21 @@ public:
     uint16 evalMipHeight(uint16 level) const { return std::max(_height >> level, 1); }
     uint16 evalMipDepth(uint16 level) const { return std::max(_depth >> level, 1); }
 
+    // Block compressed formats store lines of 4x4 texel blocks, without padding
+    static uint32 evalNumBlocks(uint32 numTexels) { return (numTexels + 3) / 4; }
+    static Size evalLineSize(uint32 width, const Element& format) {
+        return format.isBlockCompressed() ? evalNumBlocks(width) * format.getBlockSize() : evalPaddedSize(width * format.getSize());
+    }
+    static uint32 evalNumLines(uint32 height, const Element& format) { return format.isBlockCompressed() ? evalNumBlocks(height) : height; }
+    // The number of texel lines in a stored line, partial transfers of a mip start on a multiple of it
+    static uint32 evalTexelLinesPerLine(const Element& format) { return format.isBlockCompressed() ? 4 : 1; }
+
     // The size of a face is a multiple of the padded line = (width * texelFormat_size + alignment padding)
-    Size evalMipLineSize(uint16 level) const { return evalPaddedSize(evalMipWidth(level) * getTexelFormat().getSize()); }
+    Size evalMipLineSize(uint16 level) const { return evalLineSize(evalMipWidth(level), getTexelFormat()); }
 
     // Size for each face of a mip at a particular level
     uint32 evalMipFaceNumTexels(uint16 level) const { return evalMipWidth(level) * evalMipHeight(level) * evalMipDepth(level); }
-    Size evalMipFaceSize(uint16 level) const { return evalMipLineSize(level) * evalMipHeight(level) * evalMipDepth(level); }
+    Size evalMipFaceSize(uint16 level) const { return evalMipLineSize(level) * evalNumLines(evalMipHeight(level), getTexelFormat()) * evalMipDepth(level); }
     
     // Total size for the mip
     uint32 evalMipNumTexels(uint16 level) const { return evalMipFaceNumTexels(level) * getNumFaces(); }
@@ -428,9 +446,14 @@ public:
     Size evalTotalSize(uint16 startingMip = 0) const;
 
     // Compute the theorical size of the texture elements storage depending on the specified format
-    Size evalStoredMipLineSize(uint16 level, const Element& format) const { return evalPaddedSize(evalMipWidth(level) * format.getSize()); }
-    Size evalStoredMipFaceSize(uint16 level, const Element& format) const { return evalMipFaceNumTexels(level) * format.getSize(); }
-    Size evalStoredMipSize(uint16 level, const Element& format) const { return evalMipNumTexels(level) * format.getSize(); }
+    Size evalStoredMipLineSize(uint16 level, const Element& format) const { return evalLineSize(evalMipWidth(level), format); }
+    Size evalStoredMipFaceSize(uint16 level, const Element& format) const {
+        if (format.isBlockCompressed()) {
+            return evalStoredMipLineSize(level, format) * evalNumLines(evalMipHeight(level), format) * evalMipDepth(level);
+        }
+        return evalMipFaceNumTexels(level) * format.getSize();
+    }
+    Size evalStoredMipSize(uint16 level, const Element& format) const { return evalStoredMipFaceSize(level, format) * getNumFaces(); }
 
     // For convenience assign a source name 
     const std::string& source() const { return _source; }
@@ -44,8 +44,10 @@ std::string GPUKTXPayload::KEY { "hifi.gpu" };
 
 KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     {
-        ktx::StoragePointer storage { new storage::FileStorage(_filename.c_str()) };
-        auto ktxPointer = ktx::KTX::create(storage);
+        auto ktxPointer = ktx::KTX::create(mapFile());
+        if (!ktxPointer) {
+            return;
+        }
         _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
     }
 
@@ -57,12 +59,30 @@ KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     }
 }
 
+storage::StoragePointer KtxStorage::mapFile() const {
+    std::unique_lock<std::mutex> lock(_fileMutex);
+    storage::StoragePointer result = _file.lock();
+    if (!result) {
+        auto file = std::make_shared<storage::FileStorage>(_filename.c_str());
+        if (!(*file)) {
+            return nullptr;
+        }
+        _file = file;
+        result = file;
+    }
+    return result;
+}
+
 PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
     storage::StoragePointer result;
     auto faceOffset = _ktxDescriptor->getMipFaceTexelsOffset(level, face);
     auto faceSize = _ktxDescriptor->getMipFaceTexelsSize(level, face);
     if (faceSize != 0 && faceOffset != 0) {
-        result = std::make_shared<storage::FileStorage>(_filename.c_str())->createView(faceSize, faceOffset)->toMemoryStorage();
+        // A view rather than a copy, the pages of the mip are only read from disk as the transfers touch them
+        auto file = mapFile();
+        if (file) {
+            result = file->createView(faceSize, faceOffset);
+        }
     }
     return result;
 }
@@ -72,16 +92,12 @@ Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
 }
 
 void Texture::setKtxBacking(const std::string& filename) {
+    auto ktxStorage = new KtxStorage(filename);
+    auto newBacking = std::unique_ptr<Storage>(ktxStorage);
     // Check the KTX file for validity before using it as backing storage
-    {
-        ktx::StoragePointer storage { new storage::FileStorage(filename.c_str()) };
-        auto ktxPointer = ktx::KTX::create(storage);
-        if (!ktxPointer) {
-            return;
-        }
+    if (!ktxStorage->_ktxDescriptor) {
+        return;
     }
-
-    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(filename));
     setStorage(newBacking);
 }
 
@@ -194,12 +210,14 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
 }
 
 Texture* Texture::unserialize(const std::string& ktxfile, TextureUsageType usageType, Usage usage, const Sampler::Desc& sampler) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(ktx::StoragePointer { new storage::FileStorage(ktxfile.c_str()) });
-    if (!ktxPointer) {
+    // The file is parsed once, and then backs the texture without reading any of its mips
+    auto ktxStorage = new KtxStorage(ktxfile);
+    auto newBacking = std::unique_ptr<Storage>(ktxStorage);
+    if (!ktxStorage->_ktxDescriptor) {
         return nullptr;
     }
 
-    ktx::KTXDescriptor descriptor { ktxPointer->toDescriptor() };
+    const auto& descriptor = *ktxStorage->_ktxDescriptor;
     const auto& header = descriptor.header;
 
     Format mipFormat = Format::COLOR_BGRA_32;
@@ -244,8 +262,8 @@ Texture* Texture::unserialize(const std::string& ktxfile, TextureUsageType usage
     tex->setUsage((isGPUKTXPayload ? gpuktxKeyValue._usage : usage));
 
     // Assing the mips availables
+    tex->setStorage(newBacking);
     tex->setStoredMipFormat(mipFormat);
-    tex->setKtxBacking(ktxfile);
     return tex;
 }
 
@@ -260,6 +278,12 @@ bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::RGBA, ktx::GLInternalFormat_Uncompressed::SRGB8_ALPHA8, ktx::GLBaseInternalFormat::RGBA);
     } else if (texelFormat == Format::COLOR_R_8 && mipFormat == Format::COLOR_R_8) {
         header.setUncompressed(ktx::GLType::UNSIGNED_BYTE, 1, ktx::GLFormat::RED, ktx::GLInternalFormat_Uncompressed::R8, ktx::GLBaseInternalFormat::RED);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_SRGB && mipFormat == Format::COLOR_COMPRESSED_SRGB) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_S3TC_DXT1, ktx::GLBaseInternalFormat::RGB);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_SRGBA && mipFormat == Format::COLOR_COMPRESSED_SRGBA) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT5, ktx::GLBaseInternalFormat::RGBA);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_RED && mipFormat == Format::COLOR_COMPRESSED_RED) {
+        header.setCompressed(ktx::GLInternalFormat_Compressed::COMPRESSED_RED_RGTC1, ktx::GLBaseInternalFormat::RED);
     } else {
         return false;
     }
@@ -295,6 +319,22 @@ bool Texture::evalTextureFormat(const ktx::Header& header, Element& mipFormat, E
         } else {
             return false;
         }
+    } else if (header.getGLFormat() == ktx::GLFormat::COMPRESSED_FORMAT && header.getGLType() == ktx::GLType::COMPRESSED_TYPE) {
+        // the mips are stored already compressed, as they are uploaded
+        switch (header.getGLInternaFormat_Compressed()) {
+            case ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_S3TC_DXT1:
+                texelFormat = Format::COLOR_COMPRESSED_SRGB;
+                break;
+            case ktx::GLInternalFormat_Compressed::COMPRESSED_SRGB_ALPHA_S3TC_DXT5:
+                texelFormat = Format::COLOR_COMPRESSED_SRGBA;
+                break;
+            case ktx::GLInternalFormat_Compressed::COMPRESSED_RED_RGTC1:
+                texelFormat = Format::COLOR_COMPRESSED_RED;
+                break;
+            default:
+                return false;
+        }
+        mipFormat = texelFormat;
     } else {
         return false;
     }
@@ -246,6 +246,12 @@ namespace ktx {
         COMPRESSED_SRGB = 0x8C48,
         COMPRESSED_SRGB_ALPHA = 0x8C49,
 
+        // EXT_texture_compression_s3tc and EXT_texture_sRGB
+        COMPRESSED_RGB_S3TC_DXT1 = 0x83F0,
+        COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3,
+        COMPRESSED_SRGB_S3TC_DXT1 = 0x8C4C,
+        COMPRESSED_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F,
+
         COMPRESSED_RED_RGTC1 = 0x8DBB,
         COMPRESSED_SIGNED_RED_RGTC1 = 0x8DBC,
         COMPRESSED_RG_RGTC2 = 0x8DBD,
@@ -268,7 +274,7 @@ namespace ktx {
         COMPRESSED_RG11_EAC = 0x9272,
         COMPRESSED_SIGNED_RG11_EAC = 0x9273,
 
-         NUM_COMPRESSED_GLINTERNALFORMATS = 24,
+         NUM_COMPRESSED_GLINTERNALFORMATS = 28,
     };
  
     enum class GLBaseInternalFormat : uint32_t {
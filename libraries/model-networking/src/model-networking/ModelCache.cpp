@@ -115,6 +115,7 @@ void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
         _fbxGeometry = _geometryResource->_fbxGeometry;
         _meshParts = _geometryResource->_meshParts;
         _meshes = _geometryResource->_meshes;
+        _packedBlendshapes = _geometryResource->_packedBlendshapes;
         _materials = _geometryResource->_materials;
 
         // Avoid holding onto extra references
@@ -185,13 +186,19 @@ void GeometryReader::run() {
                 throw QString("unsupported format");
             }
 
+            // pack the blendshapes here rather than on the main thread, they can be large
+            PackedBlendshapes::Pointer packedBlendshapes;
+            if (fbxGeometry->hasBlendedMeshes()) {
+                packedBlendshapes = std::make_shared<PackedBlendshapes>(*fbxGeometry);
+            }
+
             // Ensure the resource has not been deleted
             auto resource = _resource.toStrongRef();
             if (!resource) {
                 qCWarning(modelnetworking) << "Abandoning load of" << _url << "; could not get strong ref";
             } else {
                 QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
-                    Q_ARG(FBXGeometry::Pointer, fbxGeometry));
+                    Q_ARG(FBXGeometry::Pointer, fbxGeometry), Q_ARG(PackedBlendshapes::Pointer, packedBlendshapes));
             }
         } else {
             throw QString("url is invalid");
@@ -219,7 +226,7 @@ public:
     virtual void downloadFinished(const QByteArray& data) override;
 
 protected:
-    Q_INVOKABLE void setGeometryDefinition(FBXGeometry::Pointer fbxGeometry);
+    Q_INVOKABLE void setGeometryDefinition(FBXGeometry::Pointer fbxGeometry, PackedBlendshapes::Pointer packedBlendshapes);
 
 private:
     QVariantHash _mapping;
@@ -230,9 +237,11 @@ void GeometryDefinitionResource::downloadFinished(const QByteArray& data) {
     QThreadPool::globalInstance()->start(new GeometryReader(_self, _url, _mapping, data, _combineParts));
 }
 
-void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxGeometry) {
+void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxGeometry,
+                                                       PackedBlendshapes::Pointer packedBlendshapes) {
     // Assume ownership of the geometry pointer
     _fbxGeometry = fbxGeometry;
+    _packedBlendshapes = packedBlendshapes;
 
     // Copy materials
     QHash<QString, size_t> materialIDAtlas;
@@ -327,6 +336,7 @@ Geometry::Geometry(const Geometry& geometry) {
     _fbxGeometry = geometry._fbxGeometry;
     _meshes = geometry._meshes;
     _meshParts = geometry._meshParts;
+    _packedBlendshapes = geometry._packedBlendshapes;
 
     _materials.reserve(geometry._materials.size());
     for (const auto& material : geometry._materials) {
@@ -19,6 +19,7 @@
 #include <model/Asset.h>
 
 #include "FBXReader.h"
+#include "PackedBlendshapes.h"
 #include "TextureCache.h"
 
 // Alias instead of derive to avoid copying
@@ -48,6 +49,8 @@ public:
 
     const FBXGeometry& getFBXGeometry() const { return *_fbxGeometry; }
     const GeometryMeshes& getMeshes() const { return *_meshes; }
+    // null if the geometry has no blendshapes
+    const PackedBlendshapes::Pointer& getPackedBlendshapes() const { return _packedBlendshapes; }
     const std::shared_ptr<const NetworkMaterial> getShapeMaterial(int shapeID) const;
 
     const QVariantMap getTextures() const;
@@ -63,6 +66,7 @@ protected:
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
     std::shared_ptr<const GeometryMeshParts> _meshParts;
+    PackedBlendshapes::Pointer _packedBlendshapes;
 
     // Copied to each geometry, mutable throughout lifetime via setTextures
     NetworkMaterials _materials;
@@ -0,0 +1,90 @@
+//
+//  PackedBlendshapes.cpp
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PackedBlendshapes.h"
+
+#include <algorithm>
+
+int packedBlendshapesPointerMetaTypeId = qRegisterMetaType<PackedBlendshapes::Pointer>();
+
+PackedBlendshapes::PackedBlendshapes(const FBXGeometry& geometry) {
+    int numBlendshapes = 0;
+    int numDeltas = 0;
+    foreach (const FBXMesh& mesh, geometry.meshes) {
+        if (!mesh.blendshapes.isEmpty()) {
+            _baseVertices += mesh.vertices;
+            _baseVertices += mesh.normals;
+            numBlendshapes = std::max(numBlendshapes, mesh.blendshapes.size());
+            foreach (const FBXBlendshape& blendshape, mesh.blendshapes) {
+                numDeltas += blendshape.indices.size();
+            }
+        }
+    }
+
+    _deltas.reserve(numDeltas);
+    _blendshapeOffsets.reserve(numBlendshapes + 1);
+    for (int i = 0; i < numBlendshapes; i++) {
+        _blendshapeOffsets.push_back(_deltas.size());
+
+        uint32_t meshOffset = 0;
+        foreach (const FBXMesh& mesh, geometry.meshes) {
+            if (mesh.blendshapes.isEmpty()) {
+                continue;
+            }
+            uint32_t normalsOffset = meshOffset + mesh.vertices.size();
+
+            if (i < mesh.blendshapes.size()) {
+                const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
+                for (int j = 0; j < blendshape.indices.size(); j++) {
+                    int index = blendshape.indices.at(j);
+                    Delta delta;
+                    delta.vertex = blendshape.vertices.at(j);
+                    delta.vertexIndex = meshOffset + index;
+                    if (index < mesh.normals.size() && j < blendshape.normals.size()) {
+                        delta.normal = blendshape.normals.at(j);
+                        delta.normalIndex = normalsOffset + index;
+                    } else {
+                        delta.normal = glm::vec3(0.0f);
+                        delta.normalIndex = NO_NORMAL;
+                    }
+                    _deltas.push_back(delta);
+                }
+            }
+
+            meshOffset = normalsOffset + mesh.normals.size();
+        }
+    }
+    _blendshapeOffsets.push_back(_deltas.size());
+}
+
+void PackedBlendshapes::blend(const QVector<float>& coefficients, QVector<glm::vec3>& blendedVertices) const {
+    blendedVertices = _baseVertices;
+    glm::vec3* output = blendedVertices.data(); // detaches from the base vertices
+
+    const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+    const float EPSILON = 0.0001f;
+    int numBlendshapes = std::min(coefficients.size(), (int)_blendshapeOffsets.size() - 1);
+    for (int i = 0; i < numBlendshapes; i++) {
+        float vertexCoefficient = coefficients.at(i);
+        if (vertexCoefficient < EPSILON) {
+            continue;
+        }
+        float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+
+        const Delta* delta = _deltas.data() + _blendshapeOffsets[i];
+        const Delta* end = _deltas.data() + _blendshapeOffsets[i + 1];
+        for (; delta != end; ++delta) {
+            output[delta->vertexIndex] += delta->vertex * vertexCoefficient;
+            if (delta->normalIndex != NO_NORMAL) {
+                output[delta->normalIndex] += delta->normal * normalCoefficient;
+            }
+        }
+    }
+}
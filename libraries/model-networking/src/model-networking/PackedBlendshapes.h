@@ -0,0 +1,56 @@
+//
+//  PackedBlendshapes.h
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PackedBlendshapes_h
+#define hifi_PackedBlendshapes_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include <glm/glm.hpp>
+
+#include "FBXReader.h"
+
+// The blendshapes of a geometry, packed once when it loads and then shared by all the models using it
+//   The blended vertices of the meshes with blendshapes are laid out as in the models' blended vertex buffers:
+//   each mesh's vertices followed by its normals, the meshes one after the other.
+//   The deltas of each blendshape, across all the meshes, are contiguous and point straight into that layout.
+class PackedBlendshapes {
+public:
+    using Pointer = std::shared_ptr<const PackedBlendshapes>;
+
+    PackedBlendshapes(const FBXGeometry& geometry);
+
+    // the unblended vertices and normals
+    const QVector<glm::vec3>& getBaseVertices() const { return _baseVertices; }
+
+    // applies the coefficients to the base vertices and normals
+    void blend(const QVector<float>& coefficients, QVector<glm::vec3>& blendedVertices) const;
+
+private:
+    struct Delta {
+        glm::vec3 vertex;
+        uint32_t vertexIndex;
+        glm::vec3 normal;
+        uint32_t normalIndex; // NO_NORMAL if the mesh has no normal for the vertex
+    };
+
+    static const uint32_t NO_NORMAL = (uint32_t)-1;
+
+    QVector<glm::vec3> _baseVertices;
+    std::vector<Delta> _deltas;
+    std::vector<size_t> _blendshapeOffsets; // first delta of each blendshape in _deltas, and their count at the end
+};
+
+Q_DECLARE_METATYPE(PackedBlendshapes::Pointer)
+
+#endif // hifi_PackedBlendshapes_h
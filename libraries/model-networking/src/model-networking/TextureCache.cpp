@@ -404,12 +404,15 @@ protected:
 class ImageReader : public Reader {
 public:
     ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url,
-            const QByteArray& data, const std::string& hash, int maxNumPixels);
+            const QByteArray& data, int maxNumPixels);
     void read() override final;
 
 private:
     static void listSupportedImageFormats();
 
+    // Looks for a live texture or a KTX file cached from the same content, before decoding the image
+    gpu::TexturePointer findCachedTexture();
+
     QByteArray _content;
     std::string _hash;
     int _maxNumPixels;
@@ -420,41 +423,8 @@ void NetworkTexture::downloadFinished(const QByteArray& data) {
 }
 
 void NetworkTexture::loadContent(const QByteArray& content) {
-    // Hash the source image to for KTX caching
-    std::string hash;
-    {
-        QCryptographicHash hasher(QCryptographicHash::Md5);
-        hasher.addData(content);
-        hash = hasher.result().toHex().toStdString();
-    }
-
-    auto textureCache = static_cast<TextureCache*>(_cache.data());
-
-    if (textureCache != nullptr) {
-        // If we already have a live texture with the same hash, use it
-        auto texture = textureCache->getTextureByHash(hash);
-
-        // If there is no live texture, check if there's an existing KTX file
-        if (!texture) {
-            KTXFilePointer ktxFile = textureCache->_ktxCache.getFile(hash);
-            if (ktxFile) {
-                texture.reset(gpu::Texture::unserialize(ktxFile->getFilepath()));
-                if (texture) {
-                    texture = textureCache->cacheTextureByHash(hash, texture);
-                }
-            }
-        }
-
-        // If we found the texture either because it's in use or via KTX deserialization, 
-        // set the image and return immediately.
-        if (texture) {
-            setImage(texture, texture->getWidth(), texture->getHeight());
-            return;
-        }
-    }
-
-    // We failed to find an existing live or KTX texture, so trigger an image reader
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, hash, _maxNumPixels));
+    // Hashing the content and looking it up in the caches is left to the image reader, off the calling thread
+    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, _maxNumPixels));
 }
 
 Reader::Reader(const QWeakPointer<Resource>& resource, const QUrl& url) :
@@ -483,8 +453,8 @@ void Reader::run() {
 }
 
 ImageReader::ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url,
-        const QByteArray& data, const std::string& hash, int maxNumPixels) :
-    Reader(resource, url), _content(data), _hash(hash), _maxNumPixels(maxNumPixels) {
+        const QByteArray& data, int maxNumPixels) :
+    Reader(resource, url), _content(data), _maxNumPixels(maxNumPixels) {
     listSupportedImageFormats();
 
 #if DEBUG_DUMP_TEXTURE_LOADS
@@ -515,7 +485,62 @@ void ImageReader::listSupportedImageFormats() {
     });
 }
 
+gpu::TexturePointer ImageReader::findCachedTexture() {
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (!textureCache) {
+        return nullptr;
+    }
+
+    // If we already have a live texture with the same hash, use it
+    auto texture = textureCache->getTextureByHash(_hash);
+    if (texture) {
+        return texture;
+    }
+
+    // If there is no live texture, check if there's an existing KTX file
+    KTXFilePointer ktxFile = textureCache->_ktxCache.getFile(_hash);
+    if (!ktxFile) {
+        return nullptr;
+    }
+
+    // Only the KTX header is parsed here, the mips are paged in from the mapped file as the backend transfers them
+    PROFILE_RANGE_EX(resource_parse_image_ktx, __FUNCTION__, 0xffff0000, 0);
+    texture.reset(gpu::Texture::unserialize(ktxFile->getFilepath()));
+    if (!texture) {
+        return nullptr;
+    }
+
+    auto resource = _resource.lock(); // to ensure the resource is still needed
+    if (resource) {
+        // Hold on to the file so that the cache does not evict it from under the texture
+        resource.staticCast<NetworkTexture>()->_file = ktxFile;
+    }
+    return textureCache->cacheTextureByHash(_hash, texture);
+}
+
 void ImageReader::read() {
+    // Hash the source image to for KTX caching
+    {
+        QCryptographicHash hasher(QCryptographicHash::Md5);
+        hasher.addData(_content);
+        _hash = hasher.result().toHex().toStdString();
+    }
+
+    // If we found the texture either because it's in use or via KTX deserialization,
+    // set the image and return immediately.
+    auto cachedTexture = findCachedTexture();
+    if (cachedTexture) {
+        auto resource = _resource.lock(); // to ensure the resource is still needed
+        if (resource) {
+            QMetaObject::invokeMethod(resource.data(), "setImage",
+                Q_ARG(gpu::TexturePointer, cachedTexture),
+                Q_ARG(int, cachedTexture->getWidth()), Q_ARG(int, cachedTexture->getHeight()));
+        } else {
+            qCDebug(modelnetworking) << _url << "loading stopped; resource out of scope";
+        }
+        return;
+    }
+
     // Help the QImage loader by extracting the image file format from the url filename ext.
     // Some tga are not created properly without it.
     auto filename = _url.fileName().toStdString();
@@ -0,0 +1,254 @@
+//
+//  TextureCompression.cpp
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureCompression.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#include <QImage>
+
+#include <Profile.h>
+#include <ThreadHelpers.h>
+
+using namespace model;
+
+static const int BLOCK_DIMENSION = 4;
+static const int BLOCK_NUM_TEXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+
+// a row of blocks encodes 4 texel lines, so half as many rows as the mip filter per range
+static const int MIN_BLOCK_ROWS_PER_RANGE = 32;
+
+struct ColorBlock {
+    uint8_t r[BLOCK_NUM_TEXELS];
+    uint8_t g[BLOCK_NUM_TEXELS];
+    uint8_t b[BLOCK_NUM_TEXELS];
+    uint8_t a[BLOCK_NUM_TEXELS];
+};
+
+// the partial blocks on the right and bottom edges repeat the last column and line of the image
+static void fetchColorBlock(const QImage& image, int blockX, int blockY, ColorBlock& block) {
+    const int maxX = image.width() - 1;
+    const int maxY = image.height() - 1;
+    for (int y = 0; y < BLOCK_DIMENSION; ++y) {
+        auto line = reinterpret_cast<const QRgb*>(image.constScanLine(std::min(blockY * BLOCK_DIMENSION + y, maxY)));
+        for (int x = 0; x < BLOCK_DIMENSION; ++x) {
+            QRgb texel = line[std::min(blockX * BLOCK_DIMENSION + x, maxX)];
+            int i = y * BLOCK_DIMENSION + x;
+            block.r[i] = (uint8_t)qRed(texel);
+            block.g[i] = (uint8_t)qGreen(texel);
+            block.b[i] = (uint8_t)qBlue(texel);
+            block.a[i] = (uint8_t)qAlpha(texel);
+        }
+    }
+}
+
+static void fetchRedBlock(const QImage& image, int blockX, int blockY, uint8_t red[BLOCK_NUM_TEXELS]) {
+    const int maxX = image.width() - 1;
+    const int maxY = image.height() - 1;
+    for (int y = 0; y < BLOCK_DIMENSION; ++y) {
+        const uchar* line = image.constScanLine(std::min(blockY * BLOCK_DIMENSION + y, maxY));
+        for (int x = 0; x < BLOCK_DIMENSION; ++x) {
+            red[y * BLOCK_DIMENSION + x] = line[std::min(blockX * BLOCK_DIMENSION + x, maxX)];
+        }
+    }
+}
+
+// rounds each channel to the nearest of its 5 or 6 bits values, rather than truncating it
+static uint16_t packRGB565(const int color[3]) {
+    int r = (color[0] * 31 + 127) / 255;
+    int g = (color[1] * 63 + 127) / 255;
+    int b = (color[2] * 31 + 127) / 255;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void unpackRGB565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 0x1F;
+    int g = (packed >> 5) & 0x3F;
+    int b = packed & 0x1F;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+static void writeUInt16(uint16_t value, gpu::Byte* output) {
+    output[0] = (gpu::Byte)(value & 0xFF);
+    output[1] = (gpu::Byte)(value >> 8);
+}
+
+// BC1: two RGB565 end points and 2 bits per texel picking one of the 4 colors interpolated between them
+static void encodeBC1(const ColorBlock& block, gpu::Byte* output) {
+    int minColor[3] = { 255, 255, 255 };
+    int maxColor[3] = { 0, 0, 0 };
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        const int texel[3] = { block.r[i], block.g[i], block.b[i] };
+        for (int c = 0; c < 3; ++c) {
+            minColor[c] = std::min(minColor[c], texel[c]);
+            maxColor[c] = std::max(maxColor[c], texel[c]);
+        }
+    }
+
+    // pick the diagonal of the bounding box along which the colors vary, relative to red
+    int center[3];
+    for (int c = 0; c < 3; ++c) {
+        center[c] = (minColor[c] + maxColor[c]) / 2;
+    }
+    int covarianceRG = 0;
+    int covarianceRB = 0;
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        int r = block.r[i] - center[0];
+        covarianceRG += r * (block.g[i] - center[1]);
+        covarianceRB += r * (block.b[i] - center[2]);
+    }
+    if (covarianceRG < 0) {
+        std::swap(minColor[1], maxColor[1]);
+    }
+    if (covarianceRB < 0) {
+        std::swap(minColor[2], maxColor[2]);
+    }
+
+    // inset the end points by 1/16th of the range, so that the interpolated colors land closer to the texels
+    for (int c = 0; c < 3; ++c) {
+        int inset = (maxColor[c] - minColor[c]) / 16;
+        minColor[c] += inset;
+        maxColor[c] -= inset;
+    }
+
+    uint16_t color0 = packRGB565(maxColor);
+    uint16_t color1 = packRGB565(minColor);
+    // color0 > color1 selects the 4 colors mode, equal end points can only use the first one anyway
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    int palette[4][3];
+    unpackRGB565(color0, palette[0]);
+    unpackRGB565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+            const int texel[3] = { block.r[i], block.g[i], block.b[i] };
+            int bestIndex = 0;
+            int bestDistance = INT_MAX;
+            for (int index = 0; index < 4; ++index) {
+                int distance = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int delta = texel[c] - palette[index][c];
+                    distance += delta * delta;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    bestIndex = index;
+                }
+            }
+            indices |= (uint32_t)bestIndex << (2 * i);
+        }
+    }
+
+    writeUInt16(color0, output);
+    writeUInt16(color1, output + 2);
+    for (int i = 0; i < 4; ++i) {
+        output[4 + i] = (gpu::Byte)(indices >> (8 * i));
+    }
+}
+
+// BC4: two 8 bits end points and 3 bits per texel picking one of the 8 values interpolated between them
+static void encodeBC4(const uint8_t values[BLOCK_NUM_TEXELS], gpu::Byte* output) {
+    int minValue = 255;
+    int maxValue = 0;
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        minValue = std::min(minValue, (int)values[i]);
+        maxValue = std::max(maxValue, (int)values[i]);
+    }
+
+    uint64_t indices = 0;
+    if (maxValue != minValue) {
+        // value0 > value1 selects the 8 values mode
+        int palette[8];
+        palette[0] = maxValue;
+        palette[1] = minValue;
+        for (int index = 2; index < 8; ++index) {
+            palette[index] = ((8 - index) * maxValue + (index - 1) * minValue) / 7;
+        }
+
+        for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+            int bestIndex = 0;
+            int bestDistance = INT_MAX;
+            for (int index = 0; index < 8; ++index) {
+                int distance = std::abs((int)values[i] - palette[index]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    bestIndex = index;
+                }
+            }
+            indices |= (uint64_t)bestIndex << (3 * i);
+        }
+    }
+
+    output[0] = (gpu::Byte)maxValue;
+    output[1] = (gpu::Byte)minValue;
+    for (int i = 0; i < 6; ++i) {
+        output[2 + i] = (gpu::Byte)(indices >> (8 * i));
+    }
+}
+
+std::vector<gpu::Byte> model::compressImage(const QImage& srcImage, const gpu::Element& format) {
+    PROFILE_RANGE(resource_parse, "compressImage");
+    Q_ASSERT(format.isBlockCompressed());
+
+    QImage image = srcImage;
+    bool isRed = (format.getSemantic() == gpu::COMPRESSED_BC4_RED);
+    if (isRed && image.format() != QImage::Format_Grayscale8) {
+        image = image.convertToFormat(QImage::Format_Grayscale8);
+    } else if (!isRed && image.depth() != 32) {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    const int numBlocksX = (int)gpu::Texture::evalNumBlocks(image.width());
+    const int numBlocksY = (int)gpu::Texture::evalNumBlocks(image.height());
+    const int blockSize = (int)format.getBlockSize();
+    std::vector<gpu::Byte> blocks((size_t)numBlocksX * numBlocksY * blockSize);
+
+    auto compressBlockRows = [&](int firstBlockY, int endBlockY) {
+        ColorBlock block;
+        for (int blockY = firstBlockY; blockY < endBlockY; ++blockY) {
+            gpu::Byte* output = blocks.data() + (size_t)blockY * numBlocksX * blockSize;
+            for (int blockX = 0; blockX < numBlocksX; ++blockX, output += blockSize) {
+                switch (format.getSemantic()) {
+                    case gpu::COMPRESSED_BC1_SRGB:
+                        fetchColorBlock(image, blockX, blockY, block);
+                        encodeBC1(block, output);
+                        break;
+                    case gpu::COMPRESSED_BC3_SRGBA:
+                        // the alpha is encoded as a BC4 block, followed by the color as a BC1 block
+                        fetchColorBlock(image, blockX, blockY, block);
+                        encodeBC4(block.a, output);
+                        encodeBC1(block, output + 8);
+                        break;
+                    case gpu::COMPRESSED_BC4_RED:
+                        fetchRedBlock(image, blockX, blockY, block.r);
+                        encodeBC4(block.r, output);
+                        break;
+                    default:
+                        Q_UNREACHABLE();
+                }
+            }
+        }
+    };
+
+    parallelFor(numBlocksY, MIN_BLOCK_ROWS_PER_RANGE, compressBlockRows);
+
+    return blocks;
+}
@@ -0,0 +1,30 @@
+//
+//  TextureCompression.h
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_model_TextureCompression_h
+#define hifi_model_TextureCompression_h
+
+#include <vector>
+
+#include "gpu/Texture.h"
+
+class QImage;
+
+namespace model {
+
+// Compresses the image to one of the block compressed texel formats (BC1, BC3 or BC4)
+//   The end points of each 4x4 block are fitted to the range of its texels, which is fast enough to run as the
+//   textures are loaded. Large images are split across threads by rows of blocks.
+//   The color formats read 32 bits per texel images, BC4 reads the first channel of 8 bits per texel images.
+//   Returns the blocks, laid out as gpu::Texture::evalStoredMipSize() expects them.
+std::vector<gpu::Byte> compressImage(const QImage& image, const gpu::Element& format);
+
+}
+
+#endif // hifi_model_TextureCompression_h
@@ -22,10 +22,13 @@
 #include <Profile.h>
 
 #include "ModelLogging.h"
+#include "TextureCompression.h"
+#include "TextureMips.h"
 using namespace model;
 using namespace gpu;
 
-// FIXME: Declare this to enable compression
+// FIXME: Declare this to let the driver compress the linear colors and the cube maps,
+// the other compressed textures are block compressed on the cpu (see TextureCompression.h)
 //#define COMPRESS_TEXTURES
 static const uvec2 SPARSE_PAGE_SIZE(128);
 static const uvec2 MAX_TEXTURE_SIZE(4096);
@@ -207,18 +210,35 @@ const QImage& image, bool isLinear, bool doCompress) {
 
 #define CPU_MIPMAPS 1
 
-void generateMips(gpu::Texture* texture, QImage& image, bool fastResize) {
+// Block compressed textures store their mips compressed, the others store the image as is
+void assignStoredMipImage(gpu::Texture* texture, uint16 level, const QImage& image) {
+    const auto& mipFormat = texture->getStoredMipFormat();
+    if (mipFormat.isBlockCompressed()) {
+        auto blocks = compressImage(image, mipFormat);
+        texture->assignStoredMip(level, blocks.size(), blocks.data());
+    } else {
+        texture->assignStoredMip(level, image.byteCount(), image.constBits());
+    }
+}
+
+// Each mip is downsampled from the previous one, sRGB colors are averaged in linear space
+// Cutout textures keep the fraction of their texels passing the alpha test in every mip
+void generateMips(gpu::Texture* texture, const QImage& image, bool isSRGB, bool preserveAlphaCoverage = false) {
 #if CPU_MIPMAPS
     PROFILE_RANGE(resource_parse, "generateMips");
+    float alphaCoverage = preserveAlphaCoverage ? evalAlphaCoverage(image) : 1.0f;
+    QImage mipImage = image;
     auto numMips = texture->getNumMips();
     for (uint16 level = 1; level < numMips; ++level) {
         QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
-        if (fastResize) {
-            image = image.scaled(mipSize);
-            texture->assignStoredMip(level, image.byteCount(), image.constBits());
+        mipImage = downsampleImage(mipImage, mipSize, isSRGB);
+        if (preserveAlphaCoverage) {
+            // the next mip averages the unscaled alpha
+            QImage scaledMipImage = mipImage.copy();
+            scaleAlphaToCoverage(scaledMipImage, alphaCoverage);
+            assignStoredMipImage(texture, level, scaledMipImage);
         } else {
-            QImage mipImage = image.scaled(mipSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-            texture->assignStoredMip(level, mipImage.byteCount(), mipImage.constBits());
+            assignStoredMipImage(texture, level, mipImage);
         }
     }
 
@@ -227,13 +247,14 @@ void generateMips(gpu::Texture* texture, QImage& image, bool fastResize) {
 #endif
 }
 
-void generateFaceMips(gpu::Texture* texture, QImage& image, uint8 face) {
+void generateFaceMips(gpu::Texture* texture, const QImage& image, uint8 face, bool isSRGB) {
 #if CPU_MIPMAPS
     PROFILE_RANGE(resource_parse, "generateFaceMips");
+    QImage mipImage = image;
     auto numMips = texture->getNumMips();
     for (uint16 level = 1; level < numMips; ++level) {
         QSize mipSize(texture->evalMipWidth(level), texture->evalMipHeight(level));
-        QImage mipImage = image.scaled(mipSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        mipImage = downsampleImage(mipImage, mipSize, isSRGB);
         texture->assignStoredMipFace(level, face, mipImage.byteCount(), mipImage.constBits());
     }
 #else
@@ -252,7 +273,13 @@ gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImag
     if ((image.width() > 0) && (image.height() > 0)) {
         gpu::Element formatGPU;
         gpu::Element formatMip;
-        defineColorTexelFormats(formatGPU, formatMip, image, isLinear, doCompress);
+        if (doCompress && !isLinear) {
+            // Compressed on the cpu, opaque colors only need BC1 which is half the size of BC3
+            formatGPU = validAlpha ? gpu::Element::COLOR_COMPRESSED_SRGBA : gpu::Element::COLOR_COMPRESSED_SRGB;
+            formatMip = formatGPU;
+        } else {
+            defineColorTexelFormats(formatGPU, formatMip, image, isLinear, doCompress);
+        }
 
         if (isStrict) {
             theTexture = (gpu::Texture::createStrict(formatGPU, image.width(), image.height(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
@@ -269,10 +296,10 @@ gpu::Texture* TextureUsage::process2DTextureColorFromImage(const QImage& srcImag
         }
         theTexture->setUsage(usage.build());
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
+        assignStoredMipImage(theTexture, 0, image);
 
         if (generateMips) {
-            ::generateMips(theTexture, image, false);
+            ::generateMips(theTexture, image, !isLinear, validAlpha && alphaAsMask);
         }
         theTexture->setSource(srcImageName);
     }
@@ -321,7 +348,7 @@ gpu::Texture* TextureUsage::createNormalTextureFromNormalImage(const QImage& src
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
         theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
-        generateMips(theTexture, image, true);
+        generateMips(theTexture, image, false);
 
         theTexture->setSource(srcImageName);
     }
@@ -411,7 +438,7 @@ gpu::Texture* TextureUsage::createNormalTextureFromBumpImage(const QImage& srcIm
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
         theTexture->assignStoredMip(0, result.byteCount(), result.constBits());
-        generateMips(theTexture, result, true);
+        generateMips(theTexture, result, false);
 
         theTexture->setSource(srcImageName);
     }
@@ -436,18 +463,14 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromImage(const QImage& srcIma
 
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
-#ifdef COMPRESS_TEXTURES
-        gpu::Element formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
-#else
-        gpu::Element formatGPU = gpu::Element::COLOR_R_8;
-#endif
-        gpu::Element formatMip = gpu::Element::COLOR_R_8;
+        gpu::Element formatGPU = gpu::Element::COLOR_COMPRESSED_RED;
+        gpu::Element formatMip = gpu::Element::COLOR_COMPRESSED_RED;
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
-        generateMips(theTexture, image, true);
+        assignStoredMipImage(theTexture, 0, image);
+        generateMips(theTexture, image, false);
 
         theTexture->setSource(srcImageName);
     }
@@ -476,18 +499,14 @@ gpu::Texture* TextureUsage::createRoughnessTextureFromGlossImage(const QImage& s
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
 
-#ifdef COMPRESS_TEXTURES
-        gpu::Element formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
-#else
-        gpu::Element formatGPU = gpu::Element::COLOR_R_8;
-#endif
-        gpu::Element formatMip = gpu::Element::COLOR_R_8;
+        gpu::Element formatGPU = gpu::Element::COLOR_COMPRESSED_RED;
+        gpu::Element formatMip = gpu::Element::COLOR_COMPRESSED_RED;
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
-        generateMips(theTexture, image, true);
+        assignStoredMipImage(theTexture, 0, image);
+        generateMips(theTexture, image, false);
 
         theTexture->setSource(srcImageName);
     }
@@ -513,18 +532,14 @@ gpu::Texture* TextureUsage::createMetallicTextureFromImage(const QImage& srcImag
     gpu::Texture* theTexture = nullptr;
     if ((image.width() > 0) && (image.height() > 0)) {
 
-#ifdef COMPRESS_TEXTURES
-        gpu::Element formatGPU = gpu::Element(gpu::SCALAR, gpu::NUINT8, gpu::COMPRESSED_R);
-#else
-        gpu::Element formatGPU = gpu::Element::COLOR_R_8;
-#endif
-        gpu::Element formatMip = gpu::Element::COLOR_R_8;
+        gpu::Element formatGPU = gpu::Element::COLOR_COMPRESSED_RED;
+        gpu::Element formatMip = gpu::Element::COLOR_COMPRESSED_RED;
 
         theTexture = (gpu::Texture::create2D(formatGPU, image.width(), image.height(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR)));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.byteCount(), image.constBits());
-        generateMips(theTexture, image, true);
+        assignStoredMipImage(theTexture, 0, image);
+        generateMips(theTexture, image, false);
 
         theTexture->setSource(srcImageName);
     }
@@ -843,7 +858,7 @@ gpu::Texture* TextureUsage::processCubeTextureColorFromImage(const QImage& srcIm
             for (auto& face : faces) {
                 theTexture->assignStoredMipFace(0, f, face.byteCount(), face.constBits());
                 if (generateMips) {
-                    generateFaceMips(theTexture, face, f);
+                    generateFaceMips(theTexture, face, f, !isLinear);
                 }
                 f++;
             }
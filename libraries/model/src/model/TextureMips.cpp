@@ -0,0 +1,238 @@
+//
+//  TextureMips.cpp
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureMips.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <Profile.h>
+#include <ThreadHelpers.h>
+
+using namespace model;
+
+// mip rows filtered by each parallelFor range, at least
+static const int MIN_ROWS_PER_RANGE = 64;
+
+// precision of the linear colors converted back to sRGB, fine enough to round trip the darkest sRGB values
+static const int LINEAR_TO_SRGB_SIZE = 1 << 16;
+
+static const std::array<float, 256>& getSRGBToLinear() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> table;
+        for (int i = 0; i < 256; ++i) {
+            float srgb = (float)i / 255.0f;
+            table[i] = (srgb <= 0.04045f) ? srgb / 12.92f : powf((srgb + 0.055f) / 1.055f, 2.4f);
+        }
+        return table;
+    }();
+    return table;
+}
+
+static const std::vector<uint8_t>& getLinearToSRGB() {
+    static const std::vector<uint8_t> table = [] {
+        std::vector<uint8_t> table(LINEAR_TO_SRGB_SIZE);
+        for (int i = 0; i < LINEAR_TO_SRGB_SIZE; ++i) {
+            float linear = (float)i / (float)(LINEAR_TO_SRGB_SIZE - 1);
+            float srgb = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * powf(linear, 1.0f / 2.4f) - 0.055f;
+            table[i] = (uint8_t)(srgb * 255.0f + 0.5f);
+        }
+        return table;
+    }();
+    return table;
+}
+
+// the range of source texels covered by the destination texel, at least one even when shrinking a single dimension
+static void evalFootprint(int dst, int srcSize, int dstSize, int& srcBegin, int& srcEnd) {
+    srcBegin = dst * srcSize / dstSize;
+    srcEnd = std::max(srcBegin + 1, (dst + 1) * srcSize / dstSize);
+}
+
+static void downsampleRGBARows(const QImage& image, uchar* mipBits, int mipBytesPerLine, const QSize& mipSize,
+                               bool isSRGB, int beginY, int endY) {
+    const auto& srgbToLinear = getSRGBToLinear();
+    const auto& linearToSRGB = getLinearToSRGB();
+    const float INV_255 = 1.0f / 255.0f;
+
+    for (int y = beginY; y < endY; ++y) {
+        int srcBeginY, srcEndY;
+        evalFootprint(y, image.height(), mipSize.height(), srcBeginY, srcEndY);
+        QRgb* mipLine = reinterpret_cast<QRgb*>(mipBits + (size_t)y * mipBytesPerLine);
+
+        for (int x = 0; x < mipSize.width(); ++x) {
+            int srcBeginX, srcEndX;
+            evalFootprint(x, image.width(), mipSize.width(), srcBeginX, srcEndX);
+
+            float sum[3] = { 0.0f, 0.0f, 0.0f };
+            float alphaWeightedSum[3] = { 0.0f, 0.0f, 0.0f };
+            int alphaSum = 0;
+            for (int srcY = srcBeginY; srcY < srcEndY; ++srcY) {
+                const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(srcY));
+                for (int srcX = srcBeginX; srcX < srcEndX; ++srcX) {
+                    QRgb texel = line[srcX];
+                    int alpha = qAlpha(texel);
+                    float color[3];
+                    if (isSRGB) {
+                        color[0] = srgbToLinear[qRed(texel)];
+                        color[1] = srgbToLinear[qGreen(texel)];
+                        color[2] = srgbToLinear[qBlue(texel)];
+                    } else {
+                        color[0] = (float)qRed(texel) * INV_255;
+                        color[1] = (float)qGreen(texel) * INV_255;
+                        color[2] = (float)qBlue(texel) * INV_255;
+                    }
+                    for (int c = 0; c < 3; ++c) {
+                        sum[c] += color[c];
+                        alphaWeightedSum[c] += color[c] * (float)alpha;
+                    }
+                    alphaSum += alpha;
+                }
+            }
+
+            int count = (srcEndX - srcBeginX) * (srcEndY - srcBeginY);
+            int result[3];
+            for (int c = 0; c < 3; ++c) {
+                // fully transparent texels keep their plain average, there is no visible color to favor
+                float color = (alphaSum > 0) ? alphaWeightedSum[c] / (float)alphaSum : sum[c] / (float)count;
+                color = std::min(std::max(color, 0.0f), 1.0f);
+                if (isSRGB) {
+                    result[c] = linearToSRGB[(int)(color * (float)(LINEAR_TO_SRGB_SIZE - 1) + 0.5f)];
+                } else {
+                    result[c] = (int)(color * 255.0f + 0.5f);
+                }
+            }
+            mipLine[x] = qRgba(result[0], result[1], result[2], (alphaSum + count / 2) / count);
+        }
+    }
+}
+
+static void downsampleGrayscaleRows(const QImage& image, uchar* mipBits, int mipBytesPerLine, const QSize& mipSize,
+                                    int beginY, int endY) {
+    for (int y = beginY; y < endY; ++y) {
+        int srcBeginY, srcEndY;
+        evalFootprint(y, image.height(), mipSize.height(), srcBeginY, srcEndY);
+        uchar* mipLine = mipBits + (size_t)y * mipBytesPerLine;
+
+        for (int x = 0; x < mipSize.width(); ++x) {
+            int srcBeginX, srcEndX;
+            evalFootprint(x, image.width(), mipSize.width(), srcBeginX, srcEndX);
+
+            int sum = 0;
+            for (int srcY = srcBeginY; srcY < srcEndY; ++srcY) {
+                const uchar* line = image.constScanLine(srcY);
+                for (int srcX = srcBeginX; srcX < srcEndX; ++srcX) {
+                    sum += line[srcX];
+                }
+            }
+            int count = (srcEndX - srcBeginX) * (srcEndY - srcBeginY);
+            mipLine[x] = (uchar)((sum + count / 2) / count);
+        }
+    }
+}
+
+QImage model::downsampleImage(const QImage& srcImage, const QSize& mipSize, bool isSRGB) {
+    PROFILE_RANGE(resource_parse, "downsampleImage");
+    QImage image = srcImage;
+    bool isGrayscale = (image.format() == QImage::Format_Grayscale8);
+    if (!isGrayscale && image.depth() != 32) {
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    QImage mip(mipSize, image.format());
+    // grab the bits once, the threads must not detach the image concurrently
+    uchar* mipBits = mip.bits();
+    int mipBytesPerLine = mip.bytesPerLine();
+
+    parallelFor(mipSize.height(), MIN_ROWS_PER_RANGE, [&](int beginY, int endY) {
+        if (isGrayscale) {
+            downsampleGrayscaleRows(image, mipBits, mipBytesPerLine, mipSize, beginY, endY);
+        } else {
+            downsampleRGBARows(image, mipBits, mipBytesPerLine, mipSize, isSRGB, beginY, endY);
+        }
+    });
+
+    return mip;
+}
+
+static std::array<int, 256> evalAlphaHistogram(const QImage& image) {
+    std::array<int, 256> histogram;
+    histogram.fill(0);
+    for (int y = 0; y < image.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            ++histogram[qAlpha(line[x])];
+        }
+    }
+    return histogram;
+}
+
+float model::evalAlphaCoverage(const QImage& image, uint8_t cutoff) {
+    if (image.depth() != 32 || image.width() == 0 || image.height() == 0) {
+        return 1.0f;
+    }
+    auto histogram = evalAlphaHistogram(image);
+    int numCovered = 0;
+    for (int alpha = cutoff; alpha < 256; ++alpha) {
+        numCovered += histogram[alpha];
+    }
+    return (float)numCovered / (float)(image.width() * image.height());
+}
+
+void model::scaleAlphaToCoverage(QImage& mip, float coverage, uint8_t cutoff) {
+    if (mip.depth() != 32 || mip.width() == 0 || mip.height() == 0) {
+        return;
+    }
+
+    const float numTexels = (float)(mip.width() * mip.height());
+    auto histogram = evalAlphaHistogram(mip);
+    auto evalScaledCoverage = [&](float scale) {
+        int numCovered = 0;
+        for (int alpha = 0; alpha < 256; ++alpha) {
+            if ((float)alpha * scale >= (float)cutoff) {
+                numCovered += histogram[alpha];
+            }
+        }
+        return (float)numCovered / numTexels;
+    };
+
+    // the coverage grows with the scale, binary search the scale closest to the target
+    const int NUM_SEARCH_STEPS = 10;
+    const float MAX_ALPHA_SCALE = 4.0f;
+    float minScale = 0.0f;
+    float maxScale = MAX_ALPHA_SCALE;
+    float bestScale = 1.0f;
+    float bestError = fabsf(evalScaledCoverage(1.0f) - coverage);
+    for (int step = 0; step < NUM_SEARCH_STEPS; ++step) {
+        float scale = (minScale + maxScale) * 0.5f;
+        float scaledCoverage = evalScaledCoverage(scale);
+        float error = fabsf(scaledCoverage - coverage);
+        if (error < bestError) {
+            bestError = error;
+            bestScale = scale;
+        }
+        if (scaledCoverage < coverage) {
+            minScale = scale;
+        } else {
+            maxScale = scale;
+        }
+    }
+
+    if (bestScale == 1.0f) {
+        return;
+    }
+    for (int y = 0; y < mip.height(); ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(mip.scanLine(y));
+        for (int x = 0; x < mip.width(); ++x) {
+            int alpha = std::min((int)((float)qAlpha(line[x]) * bestScale + 0.5f), 255);
+            line[x] = qRgba(qRed(line[x]), qGreen(line[x]), qBlue(line[x]), alpha);
+        }
+    }
+}
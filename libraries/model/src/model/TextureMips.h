@@ -0,0 +1,35 @@
+//
+//  TextureMips.h
+//  libraries/model/src/model
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_model_TextureMips_h
+#define hifi_model_TextureMips_h
+
+#include <QImage>
+
+namespace model {
+
+// The alpha test threshold of the opacity mask materials
+const uint8_t ALPHA_MASK_CUTOFF = 128;
+
+// Box filters the image down to the mip size, each texel averaging the texels of the image it covers
+//   sRGB colors are averaged in linear space, and the colors are weighted by their alpha so that the fully
+//   transparent texels do not bleed into their neighbours. The rows of large mips are split across threads.
+//   Reads and returns 32 bits per texel images, or QImage::Format_Grayscale8 images.
+QImage downsampleImage(const QImage& image, const QSize& mipSize, bool isSRGB);
+
+// Returns the fraction of the texels that pass the alpha test
+float evalAlphaCoverage(const QImage& image, uint8_t cutoff = ALPHA_MASK_CUTOFF);
+
+// Scales the alpha of the mip so that the same fraction of its texels pass the alpha test as in the base image
+//   Otherwise the averaged alpha of the smaller mips makes cutout foliage and fences thin out with distance.
+void scaleAlphaToCoverage(QImage& mip, float coverage, uint8_t cutoff = ALPHA_MASK_CUTOFF);
+
+}
+
+#endif // hifi_model_TextureMips_h
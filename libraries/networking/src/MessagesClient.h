@@ -39,6 +39,9 @@ public:
     static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
 
+    // reads only the channel, the rest of the message follows it
+    static QString decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage);
+
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
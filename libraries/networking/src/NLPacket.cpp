@@ -11,10 +11,12 @@
 
 #include "NLPacket.h"
 
+#include <SipHash.h>
+
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = NON_SOURCED_PACKETS.contains(type);
     bool nonVerified = NON_VERIFIED_PACKETS.contains(type);
-    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_RFC4122_UUID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_MD5_HASH);
+    qint64 optionalSize = (nonSourced ? 0 : NUM_BYTES_RFC4122_UUID) + ((nonSourced || nonVerified) ? 0 : NUM_BYTES_VERIFICATION_HASH);
     return sizeof(PacketType) + sizeof(PacketVersion) + optionalSize;
 }
 int NLPacket::totalHeaderSize(PacketType type, bool isPartOfMessage) {
@@ -146,21 +148,49 @@ QUuid NLPacket::sourceIDInHeader(const udt::Packet& packet) {
 
 QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_RFC4122_UUID;
-    return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
+    return QByteArray(packet.getData() + offset, NUM_BYTES_VERIFICATION_HASH);
 }
 
 QByteArray NLPacket::hashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret) {
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    
+    QByteArray hash(NUM_BYTES_VERIFICATION_HASH, 0);
+    computeHashForPacketAndSecret(packet, connectionSecret, hash.data());
+    return hash;
+}
+
+void NLPacket::computeHashForPacketAndSecret(const udt::Packet& packet, const QUuid& connectionSecret, char* hash) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
-        + NUM_BYTES_RFC4122_UUID + NUM_BYTES_MD5_HASH;
-    
-    // add the packet payload and the connection UUID
-    hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
-    hash.addData(connectionSecret.toRfc4122());
-    
-    // return the hash
-    return hash.result();
+        + NUM_BYTES_RFC4122_UUID + NUM_BYTES_VERIFICATION_HASH;
+
+    if (PACKET_VERIFICATION_VERSION == PacketVerificationVersion::MD5) {
+        QCryptographicHash md5Hash(QCryptographicHash::Md5);
+
+        // add the packet payload and the connection UUID
+        md5Hash.addData(packet.getData() + offset, packet.getDataSize() - offset);
+        md5Hash.addData(connectionSecret.toRfc4122());
+
+        memcpy(hash, md5Hash.result().constData(), NUM_BYTES_VERIFICATION_HASH);
+    } else {
+        // the connection UUID is the key, taken in its RFC 4122 byte order
+        uint64_t key0 = ((uint64_t)connectionSecret.data1 << 32) | ((uint64_t)connectionSecret.data2 << 16)
+            | connectionSecret.data3;
+        uint64_t key1 = 0;
+        for (auto byte : connectionSecret.data4) {
+            key1 = (key1 << 8) | byte;
+        }
+
+        sipHash128(key0, key1, packet.getData() + offset, packet.getDataSize() - offset,
+                   reinterpret_cast<uint8_t*>(hash));
+    }
+}
+
+bool NLPacket::verificationHashMatches(const udt::Packet& packet, const QUuid& connectionSecret) {
+    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_RFC4122_UUID;
+
+    char expectedHash[NUM_BYTES_VERIFICATION_HASH];
+    computeHashForPacketAndSecret(packet, connectionSecret, expectedHash);
+
+    return memcmp(packet.getData() + offset, expectedHash, NUM_BYTES_VERIFICATION_HASH) == 0;
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -217,7 +247,5 @@ void NLPacket::writeVerificationHashGivenSecret(const QUuid& connectionSecret) c
     
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_RFC4122_UUID;
-    QByteArray verificationHash = hashForPacketAndSecret(*this, connectionSecret);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    computeHashForPacketAndSecret(*this, connectionSecret, _packet.get() + offset);
 }
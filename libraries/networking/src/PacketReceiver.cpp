@@ -13,12 +13,45 @@
 #include "PacketReceiver.h"
 
 #include <QMutexLocker>
+#include <QThread>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "SharedUtil.h"
 
+PacketListenerQueue::PacketListenerQueue(QObject* listener) :
+    _batch(std::make_shared<Batch>())
+{
+    // queued to the listener's thread at emit time, so this follows the listener if it is moved to another thread
+    auto batch = _batch;
+    connect(this, &PacketListenerQueue::messagesQueued, listener, [batch] {
+        std::vector<QueuedMessage> messages;
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            messages.swap(batch->messages);
+        }
+        for (auto& queuedMessage : messages) {
+            (*queuedMessage.handler)(queuedMessage.message, queuedMessage.node);
+        }
+    });
+}
+
+void PacketListenerQueue::push(const TypedPacketHandlerPointer& handler, QSharedPointer<ReceivedMessage> message,
+                               SharedNodePointer node) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(_batch->mutex);
+        wasEmpty = _batch->messages.empty();
+        _batch->messages.push_back({ handler, message, node });
+    }
+
+    // the messages pushed until the listener drains the batch ride along with this one
+    if (wasEmpty) {
+        emit messagesQueued();
+    }
+}
+
 PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
@@ -169,13 +202,51 @@ void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object,
     Q_ASSERT_X(object, "PacketReceiver::registerVerifiedListener", "No object to register");
     QMutexLocker locker(&_packetListenerLock);
 
-    if (_messageListenerMap.contains(type)) {
+    Listener listener;
+    listener.object = object;
+    listener.method = slot;
+    listener.deliverPending = deliverPending;
+    registerListenerEntry(type, listener);
+}
+
+bool PacketReceiver::registerTypedListener(PacketType type, QObject* object, TypedPacketHandler handler,
+                                           bool handlerNeedsNode, bool deliverPending) {
+    Q_ASSERT_X(object, "PacketReceiver::registerTypedListener", "No object to register");
+    QMutexLocker locker(&_packetListenerLock);
+
+    qCDebug(networking) << "Registering a typed packet listener for packet list type" << type;
+
+    if (_listenerQueues.find(object) == _listenerQueues.end()) {
+        _listenerQueues[object].reset(new PacketListenerQueue(object));
+
+        // direct, so that the queue is gone before another object can be allocated at the same address
+        connect(object, &QObject::destroyed, this, [this, object] {
+            QMutexLocker locker(&_packetListenerLock);
+            _listenerQueues.erase(object);
+        }, Qt::DirectConnection);
+    }
+
+    Listener listener;
+    listener.object = object;
+    listener.handler = std::make_shared<const TypedPacketHandler>(std::move(handler));
+    listener.handlerNeedsNode = handlerNeedsNode;
+    listener.deliverPending = deliverPending;
+    registerListenerEntry(type, listener);
+
+    return true;
+}
+
+void PacketReceiver::registerListenerEntry(PacketType type, Listener listener) {
+    Listener& entry = _messageListeners[(size_t)type];
+
+    if (entry.isRegistered) {
         qCWarning(networking) << "Registering a packet listener for packet type" << type
             << "that will remove a previously registered listener";
     }
-    
+
     // add the mapping
-    _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
+    listener.isRegistered = true;
+    entry = listener;
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
@@ -184,16 +255,13 @@ void PacketReceiver::unregisterListener(QObject* listener) {
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
         
-        // clear any registrations for this listener in _messageListenerMap
-        auto it = _messageListenerMap.begin();
-        
-        while (it != _messageListenerMap.end()) {
-            if (it.value().object == listener) {
-                it = _messageListenerMap.erase(it);
-            } else {
-                ++it;
+        // clear any registrations for this listener in _messageListeners
+        for (auto& entry : _messageListeners) {
+            if (entry.isRegistered && entry.object == listener) {
+                entry = Listener();
             }
         }
+        _listenerQueues.erase(listener);
     }
     
     QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
@@ -269,11 +337,11 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
     
     bool listenerIsDead = false;
     
-    auto it = _messageListenerMap.find(receivedMessage->getType());
+    Listener& entry = _messageListeners[(size_t)receivedMessage->getType()];
             
-    if (it != _messageListenerMap.end() && it->method.isValid()) {
+    if (entry.isRegistered && (entry.method.isValid() || entry.handler)) {
          
-        auto listener = it.value();
+        auto listener = entry;
 
         if ((listener.deliverPending && !justReceived) || (!listener.deliverPending && !receivedMessage->isComplete())) {
             return;
@@ -295,7 +363,23 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
             
             if (matchingNode) {
                 matchingNode->recordBytesReceived(receivedMessage->getSize());
+            }
 
+            if (listener.handler) {
+                if (listener.handlerNeedsNode && !matchingNode) {
+                    // same as the slots taking a node, which cannot be invoked without one
+                    success = false;
+                } else if (connectionType == Qt::DirectConnection || listener.object->thread() == QThread::currentThread()) {
+                    (*listener.handler)(receivedMessage, matchingNode);
+                    success = true;
+                } else {
+                    auto it = _listenerQueues.find(listener.object);
+                    if (it != _listenerQueues.end()) {
+                        it->second->push(listener.handler, receivedMessage, matchingNode);
+                        success = true;
+                    }
+                }
+            } else if (matchingNode) {
                 QMetaMethod metaMethod = listener.method;
                 
                 static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
@@ -334,9 +418,10 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
                 
             }
             
-            if (!success) {
+            if (!success && !listenerIsDead) {
                 qCDebug(networking).nospace() << "Error delivering packet " << packetType << " to listener "
-                    << listener.object << "::" << qPrintable(listener.method.methodSignature());
+                    << listener.object << "::" << qPrintable(listener.handler ? QByteArray("<typed listener>") :
+                                                                                listener.method.methodSignature());
             }
             
         } else {
@@ -346,7 +431,7 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         if (listenerIsDead) {
             qCDebug(networking).nospace() << "Listener for packet " << receivedMessage->getType()
                 << " has been destroyed. Removing from listener map.";
-            it = _messageListenerMap.erase(it);
+            entry = Listener();
             
             // if it exists, remove the listener from _directlyConnectedObjects
             {
@@ -354,10 +439,10 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
                 _directlyConnectedObjects.remove(listener.object);
             }
         }
-    } else if (it == _messageListenerMap.end()) {
+    } else if (!entry.isRegistered) {
         qCWarning(networking) << "No listener found for packet type" << receivedMessage->getType();
         
         // insert a dummy listener so we don't print this again
-        _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false });
+        entry.isRegistered = true;
     }
 }
@@ -13,6 +13,12 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <array>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 
@@ -25,6 +31,7 @@
 
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "Node.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
@@ -40,6 +47,36 @@ namespace std {
     };
 }
 
+using TypedPacketHandler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+using TypedPacketHandlerPointer = std::shared_ptr<const TypedPacketHandler>;
+
+// Messages for the typed listeners of an object living on another thread than the PacketReceiver
+//   They are drained in batches on the object's thread: one queued call per batch, instead of one per message.
+class PacketListenerQueue : public QObject {
+    Q_OBJECT
+public:
+    PacketListenerQueue(QObject* listener);
+
+    void push(const TypedPacketHandlerPointer& handler, QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+
+signals:
+    void messagesQueued();
+
+private:
+    struct QueuedMessage {
+        TypedPacketHandlerPointer handler;
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer node;
+    };
+    struct Batch {
+        std::mutex mutex;
+        std::vector<QueuedMessage> messages;
+    };
+
+    // shared with the drain call, which can still be pending on the listener's thread once this is destroyed
+    std::shared_ptr<Batch> _batch;
+};
+
 class PacketReceiver : public QObject {
     Q_OBJECT
 public:
@@ -62,6 +99,20 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+
+    // Typed listeners are called through their member function pointer rather than QMetaMethod::invoke, and the
+    // messages for listeners on other threads are delivered in batches (see PacketListenerQueue).
+    template <typename T>
+    bool registerListener(PacketType type, T* listener,
+                          void (T::*method)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                          bool deliverPending = false);
+    template <typename T>
+    bool registerListener(PacketType type, T* listener, void (T::*method)(QSharedPointer<ReceivedMessage>),
+                          bool deliverPending = false);
+    template <typename T>
+    bool registerListenerForTypes(PacketTypeList types, T* listener,
+                                  void (T::*method)(QSharedPointer<ReceivedMessage>, SharedNodePointer));
+
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
@@ -72,9 +123,14 @@ private:
     struct Listener {
         QPointer<QObject> object;
         QMetaMethod method;
-        bool deliverPending;
+        TypedPacketHandlerPointer handler; // set instead of the method for typed listeners
+        bool handlerNeedsNode { false };
+        bool deliverPending { false };
+        bool isRegistered { false };
     };
 
+    static const size_t NUM_PACKET_TYPES = (size_t)std::numeric_limits<std::underlying_type<PacketType>::type>::max() + 1;
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
@@ -84,9 +140,15 @@ private:
 
     QMetaMethod matchingMethodForListener(PacketType type, QObject* object, const char* slot) const;
     void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot, bool deliverPending = false);
+    bool registerTypedListener(PacketType type, QObject* listener, TypedPacketHandler handler, bool handlerNeedsNode,
+                               bool deliverPending);
+
+    // requires _packetListenerLock
+    void registerListenerEntry(PacketType type, Listener listener);
 
     QMutex _packetListenerLock;
-    QHash<PacketType, Listener> _messageListenerMap;
+    std::array<Listener, NUM_PACKET_TYPES> _messageListeners; // indexed by packet type
+    std::unordered_map<QObject*, std::unique_ptr<PacketListenerQueue>> _listenerQueues; // by typed listener object
     int _inPacketCount = 0;
     int _inByteCount = 0;
     bool _shouldDropPackets = false;
@@ -99,4 +161,37 @@ private:
     friend class OctreePacketProcessor;
 };
 
+template <typename T>
+bool PacketReceiver::registerListener(PacketType type, T* listener,
+                                      void (T::*method)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                                      bool deliverPending) {
+    Q_ASSERT_X(!NON_SOURCED_PACKETS.contains(type), "PacketReceiver::registerListener",
+               "Non sourced packets have no node to pass to the listener");
+    return registerTypedListener(type, listener,
+        [listener, method](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            (listener->*method)(message, node);
+        }, true, deliverPending);
+}
+
+template <typename T>
+bool PacketReceiver::registerListener(PacketType type, T* listener, void (T::*method)(QSharedPointer<ReceivedMessage>),
+                                      bool deliverPending) {
+    return registerTypedListener(type, listener,
+        [listener, method](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            (listener->*method)(message);
+        }, false, deliverPending);
+}
+
+template <typename T>
+bool PacketReceiver::registerListenerForTypes(PacketTypeList types, T* listener,
+                                              void (T::*method)(QSharedPointer<ReceivedMessage>, SharedNodePointer)) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
+
+    bool success = true;
+    for (auto type : types) {
+        success = registerListener(type, listener, method) && success;
+    }
+    return success;
+}
+
 #endif // hifi_PacketReceiver_h
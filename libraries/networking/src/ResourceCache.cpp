@@ -15,6 +15,7 @@
 #include <QThread>
 #include <QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <assert.h>
 
@@ -30,23 +31,76 @@
                            (((x) > (max)) ? (max) :\
                                             (x)))
 
-void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
+// the request limit of an origin is adapted between the base limit and this multiple of it
+static const int MAX_REQUEST_LIMIT_MULTIPLIER = 4;
+
+// the throughput of an origin is compared every interval, and must change by the threshold to adapt its limit
+static const quint64 REQUEST_LIMIT_ADAPTATION_INTERVAL_USECS = 2 * USECS_PER_SECOND;
+static const float REQUEST_LIMIT_ADAPTATION_THRESHOLD = 0.1f;
+
+ResourceCacheSharedItems::Origin ResourceCacheSharedItems::getOrigin(const QUrl& url) {
+    auto scheme = url.scheme();
+    if (scheme == URL_SCHEME_ATP) {
+        return ATP;
+    } else if (scheme == URL_SCHEME_HTTP || scheme == URL_SCHEME_HTTPS || scheme == URL_SCHEME_FTP) {
+        return HTTP;
+    } else if (scheme == URL_SCHEME_FILE || scheme.isEmpty()) {
+        return File;
+    }
+    return Other;
+}
+
+bool ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return false;
+    }
+    auto origin = getOrigin(strongResource->getURL());
+
     Lock lock(_mutex);
-    _loadingRequests.append(resource);
+    auto& originRequests = _origins[origin];
+    if (originRequests.numLoading >= getLimit(originRequests)) {
+        originRequests.wasSaturated = true;
+        return false;
+    }
+
+    ++originRequests.numLoading;
+    _loadingRequests.append({ resource, origin });
+    return true;
 }
 
 void ResourceCacheSharedItems::appendPendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    auto origin = getOrigin(strongResource->getURL());
+
     Lock lock(_mutex);
-    _pendingRequests.append(resource);
+    float priority = strongResource->getLoadPriority();
+    _origins[origin].pending.push({ resource, strongResource.data(), priority, _nextSequence++ });
+}
+
+void ResourceCacheSharedItems::updatePendingRequest(QWeakPointer<Resource> resource) {
+    auto strongResource = resource.lock();
+    if (!strongResource) {
+        return;
+    }
+    auto origin = getOrigin(strongResource->getURL());
+
+    Lock lock(_mutex);
+    _origins[origin].pending.update(strongResource.data(), strongResource->getLoadPriority());
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _pendingRequests) {
-        if (resource) {
-            result.append(resource);
+    for (auto& origin : _origins) {
+        for (auto& request : origin.pending.getRequests()) {
+            if (auto resource = request.resource.lock()) {
+                result.append(resource);
+            }
         }
     }
 
@@ -55,15 +109,20 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() {
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+
+    uint32_t count = 0;
+    for (auto& origin : _origins) {
+        count += origin.pending.size();
+    }
+    return count;
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QSharedPointer<Resource> resource, _loadingRequests) {
-        if (resource) {
+    for (auto& request : _loadingRequests) {
+        if (auto resource = request.resource.lock()) {
             result.append(resource);
         }
     }
@@ -76,16 +135,27 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+int ResourceCacheSharedItems::getRequestLimit(Origin origin) const {
+    Lock lock(_mutex);
+    return getLimit(_origins[origin]);
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
+    // the size is read before locking, as a resource that is being destroyed cannot be locked anymore
+    auto strongResource = resource.lock();
+    qint64 bytes = strongResource ? strongResource->getBytes() : 0;
+
     Lock lock(_mutex);
 
     // resource can only be removed if it still has a ref-count, as
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto& request = _loadingRequests[i];
         // Clear our resource and any freed resources
-        if (!request || request.data() == resource.data()) {
+        bool isFreed = !request.resource;
+        if (isFreed || request.resource.data() == resource.data()) {
+            requestFinished(_origins[request.origin], isFreed ? 0 : bytes);
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -94,37 +164,183 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
+    // look for the highest priority pending request, among origins with a free request slot
     QSharedPointer<Resource> highestResource;
+    OriginRequests* highestOrigin = nullptr;
     Lock lock(_mutex);
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
+    for (auto& origin : _origins) {
+        if (origin.numLoading >= getLimit(origin)) {
+            origin.wasSaturated = origin.wasSaturated || !origin.pending.isEmpty();
             continue;
         }
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        if (priority >= highestPriority) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
+        auto& pending = origin.pending;
+        while (!pending.isEmpty()) {
+            auto& top = pending.top();
+
+            // Clear any freed resources
+            auto resource = top.resource.lock();
+            if (!resource) {
+                pending.pop();
+                continue;
+            }
+
+            // priorities drop without notice when their owners are destroyed, so re-check the top
+            float priority = resource->getLoadPriority();
+            if (priority != top.priority) {
+                pending.update(top.key, priority);
+                continue;
+            }
+
+            if (!highestResource || priority >= highestOrigin->pending.top().priority) {
+                highestResource = resource;
+                highestOrigin = &origin;
+            }
+            break;
         }
-        i++;
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    if (highestOrigin) {
+        highestOrigin->pending.pop();
     }
 
     return highestResource;
 }
 
+int ResourceCacheSharedItems::getLimit(const OriginRequests& origin) {
+    int baseLimit = ResourceCache::getRequestLimit();
+    return baseLimit + clamp(origin.extraRequests, 0, baseLimit * (MAX_REQUEST_LIMIT_MULTIPLIER - 1));
+}
+
+void ResourceCacheSharedItems::requestFinished(OriginRequests& origin, qint64 bytes) {
+    --origin.numLoading;
+
+    auto now = usecTimestampNow();
+    if (origin.intervalStart == 0) {
+        origin.intervalStart = now;
+    }
+    origin.intervalBytes += bytes;
+
+    auto elapsed = now - origin.intervalStart;
+    if (elapsed < REQUEST_LIMIT_ADAPTATION_INTERVAL_USECS) {
+        return;
+    }
+
+    float throughput = (float)origin.intervalBytes / elapsed;
+
+    // only origins that used all their slots tell us anything about their limit
+    if (origin.wasSaturated) {
+        int baseLimit = ResourceCache::getRequestLimit();
+        if (throughput > origin.lastThroughput * (1.0f + REQUEST_LIMIT_ADAPTATION_THRESHOLD)) {
+            // more concurrent requests are still paying off
+            ++origin.extraRequests;
+        } else if (throughput < origin.lastThroughput * (1.0f - REQUEST_LIMIT_ADAPTATION_THRESHOLD)) {
+            // the origin is overloaded
+            --origin.extraRequests;
+        }
+        origin.extraRequests = clamp(origin.extraRequests, 0, baseLimit * (MAX_REQUEST_LIMIT_MULTIPLIER - 1));
+    }
+
+    origin.lastThroughput = throughput;
+    origin.intervalStart = now;
+    origin.intervalBytes = 0;
+    origin.wasSaturated = false;
+}
+
+void ResourceCacheSharedItems::PendingRequestQueue::push(PendingRequest request) {
+    auto it = _indices.find(request.key);
+    if (it != _indices.end()) {
+        int index = it.value();
+        if (_heap[index].resource) {
+            // already pending
+            update(request.key, request.priority);
+            return;
+        }
+        // a freed resource at the same address
+        removeAt(index);
+    }
+
+    _heap.push_back(request);
+    _indices[request.key] = (int)_heap.size() - 1;
+    siftUp((int)_heap.size() - 1);
+}
+
+bool ResourceCacheSharedItems::PendingRequestQueue::update(Resource* key, float priority) {
+    auto it = _indices.find(key);
+    if (it == _indices.end()) {
+        return false;
+    }
+
+    int index = it.value();
+    float oldPriority = _heap[index].priority;
+    _heap[index].priority = priority;
+    if (priority > oldPriority) {
+        siftUp(index);
+    } else {
+        siftDown(index);
+    }
+    return true;
+}
+
+void ResourceCacheSharedItems::PendingRequestQueue::removeAt(int index) {
+    _indices.remove(_heap[index].key);
+
+    int last = (int)_heap.size() - 1;
+    if (index != last) {
+        place(index, std::move(_heap[last]));
+        _heap.pop_back();
+
+        // the moved request may belong either above or below
+        siftUp(index);
+        siftDown(index);
+    } else {
+        _heap.pop_back();
+    }
+}
+
+void ResourceCacheSharedItems::PendingRequestQueue::place(int index, PendingRequest request) {
+    _indices[request.key] = index;
+    _heap[index] = std::move(request);
+}
+
+void ResourceCacheSharedItems::PendingRequestQueue::siftUp(int index) {
+    PendingRequest request = std::move(_heap[index]);
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!isHigher(request, _heap[parent])) {
+            break;
+        }
+        place(index, std::move(_heap[parent]));
+        index = parent;
+    }
+    place(index, std::move(request));
+}
+
+void ResourceCacheSharedItems::PendingRequestQueue::siftDown(int index) {
+    int size = (int)_heap.size();
+    if (index >= size) {
+        return;
+    }
+
+    PendingRequest request = std::move(_heap[index]);
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && isHigher(_heap[child + 1], _heap[child])) {
+            ++child;
+        }
+        if (!isHigher(_heap[child], request)) {
+            break;
+        }
+        place(index, std::move(_heap[child]));
+        index = child;
+    }
+    place(index, std::move(request));
+}
+
 ScriptableResource::ScriptableResource(const QUrl& url) :
     QObject(nullptr),
     _url(url) { }
@@ -476,14 +692,13 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
-    if (_requestsActive >= _requestLimit) {
-        // wait until a slot becomes available
+    if (!sharedItems->appendActiveRequest(resource)) {
+        // wait until a slot becomes available for the origin of this resource
         sharedItems->appendPendingRequest(resource);
         return false;
     }
     
     ++_requestsActive;
-    sharedItems->appendActiveRequest(resource);
     resource->makeRequest();
     return true;
 }
@@ -493,7 +708,10 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
     --_requestsActive;
 
-    attemptHighestPriorityRequest();
+    // the request limit of its origin may have been raised, so fill any free request slots
+    while (attemptHighestPriorityRequest()) {
+        // just keep looping until we reach the limits or no more pending requests
+    }
 }
 
 bool ResourceCache::attemptHighestPriorityRequest() {
@@ -533,6 +751,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.insert(owner, priority);
+        updatePendingRequest();
     }
 }
 
@@ -544,11 +763,20 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updatePendingRequest();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!(_failedToLoad || _loaded)) {
         _loadPriorities.remove(owner);
+        updatePendingRequest();
+    }
+}
+
+void Resource::updatePendingRequest() {
+    if (_startedLoading && !_request) {
+        // we may be waiting for a request slot, re-prioritize
+        DependencyManager::get<ResourceCacheSharedItems>()->updatePendingRequest(_self);
     }
 }
 
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -66,21 +67,94 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
+    // requests are limited per origin, so that slow servers do not hold up others
+    enum Origin {
+        ATP,
+        HTTP,
+        File,
+        Other,
+        NumOrigins
+    };
+
+    static Origin getOrigin(const QUrl& url);
+
     void appendPendingRequest(QWeakPointer<Resource> newRequest);
-    void appendActiveRequest(QWeakPointer<Resource> newRequest);
+    void updatePendingRequest(QWeakPointer<Resource> request); // call when the load priority changes
+
+    // returns false (and does not append) if the origin of the request has no free request slot
+    bool appendActiveRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
     QList<QSharedPointer<Resource>> getPendingRequests();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests();
+
+    // returns the highest priority pending request of an origin with a free request slot
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
 
+    int getRequestLimit(Origin origin) const;
+
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key;
+        float priority;
+        uint64_t sequence;
+    };
+
+    // max-heap of pending requests, indexed by resource so that their priority can be updated
+    class PendingRequestQueue {
+    public:
+        bool isEmpty() const { return _heap.empty(); }
+        int size() const { return (int)_heap.size(); }
+        const std::vector<PendingRequest>& getRequests() const { return _heap; }
+
+        void push(PendingRequest request);
+        bool update(Resource* key, float priority); // returns false if the resource is not pending here
+        const PendingRequest& top() const { return _heap.front(); }
+        void pop() { removeAt(0); }
+
+    private:
+        // ties go to the latest request
+        bool isHigher(const PendingRequest& a, const PendingRequest& b) const {
+            return a.priority > b.priority || (a.priority == b.priority && a.sequence > b.sequence);
+        }
+        void removeAt(int index);
+        void place(int index, PendingRequest request);
+        void siftUp(int index);
+        void siftDown(int index);
+
+        std::vector<PendingRequest> _heap;
+        QHash<Resource*, int> _indices;
+    };
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        Origin origin;
+    };
+
+    struct OriginRequests {
+        PendingRequestQueue pending;
+        int numLoading { 0 };
+        int extraRequests { 0 }; // adapted number of requests allowed above ResourceCache::getRequestLimit()
+
+        // throughput of the current adaptation interval
+        quint64 intervalStart { 0 };
+        qint64 intervalBytes { 0 };
+        bool wasSaturated { false }; // requests had to wait for a slot during the interval
+        float lastThroughput { 0.0f };
+    };
+
+    // requires _mutex
+    static int getLimit(const OriginRequests& origin);
+    void requestFinished(OriginRequests& origin, qint64 bytes);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    OriginRequests _origins[NumOrigins];
+    uint64_t _nextSequence { 0 };
+    QList<LoadingRequest> _loadingRequests;
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -462,6 +536,7 @@ private:
     void makeRequest();
     void retry();
     void reinsert();
+    void updatePendingRequest(); // re-prioritizes the pending request, if any
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
@@ -125,6 +125,10 @@ static void ensureProtocolVersionsSignature() {
             uint8_t packetTypeVersion = static_cast<uint8_t>(versionForPacketType(static_cast<PacketType>(packetType)));
             stream << packetTypeVersion;
         }
+        // left out for MD5, so that the signature is the same as before the hash was versioned
+        if (PACKET_VERIFICATION_VERSION != PacketVerificationVersion::MD5) {
+            stream << static_cast<uint8_t>(PACKET_VERIFICATION_VERSION);
+        }
         QCryptographicHash hash(QCryptographicHash::Md5);
         hash.addData(buffer);
         protocolVersionSignature = hash.result();
@@ -121,6 +121,14 @@ using PacketType = PacketTypeEnum::Value;
 
 const int NUM_BYTES_MD5_HASH = 16;
 
+// The keyed hash verifying the sourced packets, part of the protocol signature
+enum class PacketVerificationVersion : uint8_t {
+    MD5 = 0,
+    SipHash = 1
+};
+const PacketVerificationVersion PACKET_VERIFICATION_VERSION = PacketVerificationVersion::SipHash;
+const int NUM_BYTES_VERIFICATION_HASH = 16;
+
 typedef char PacketVersion;
 
 extern const QSet<PacketType> NON_VERIFIED_PACKETS;
@@ -13,7 +13,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -39,6 +38,7 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
+class SendQueueScheduler;
     
 class SendQueue : public QObject {
     Q_OBJECT
@@ -87,15 +87,24 @@ signals:
     void shortCircuitLoss(quint32 sequenceNumber);
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    using TimePoint = p_high_resolution_clock::time_point;
+
     SendQueue(Socket* socket, HifiSockAddr dest);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
-    void sendHandshake();
+    // Called by the SendQueueScheduler, one thread at a time
+    // Sends what is due and returns the time to be serviced next (or SendQueueScheduler::STOPPED)
+    TimePoint service();
+
+    // Has the SendQueueScheduler service this queue as soon as possible, if it is waiting
+    // (for the handshake ACK, or for data to handle) - a queue pacing its sends is not woken
+    void wake();
+    bool isWaiting() const { return !_isSending || _isIdleWaiting; }
+
+    TimePoint sendHandshake(TimePoint now);
+    TimePoint getNextPacketTime(int newPacketCount); // Paces sends by the packet send period
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
@@ -103,7 +112,8 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    bool isInactive(bool attemptedToSendPacket, TimePoint now);
+    bool finishIdleWait(bool timedOut); // returns true if the queue was deactivated
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -139,14 +149,18 @@ private:
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
-
 
     std::atomic<bool> _shouldSendProbes { true };
+
+    // Only accessed while serviced by the SendQueueScheduler
+    bool _isSending { false }; // Handshake is complete and packets are being sent
+    TimePoint _nextHandshakeTimestamp; // When to re-send a handshake
+    TimePoint _nextPacketTimestamp; // When the next packet should have been sent
+    TimePoint _idleWaitTimestamp; // End of the wait for new data or a response from the receiver, if waiting
+    bool _isIdleWaiting { false };
+
+    friend class SendQueueScheduler;
 };
     
 }
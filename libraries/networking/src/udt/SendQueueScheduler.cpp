@@ -0,0 +1,159 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include "SendQueue.h"
+
+using namespace udt;
+
+const SendQueueScheduler::TimePoint SendQueueScheduler::STOPPED = SendQueueScheduler::TimePoint::max();
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    // intentionally leaked, a SendQueue destroyed during static teardown must still find it to be removed from
+    static SendQueueScheduler* scheduler = new SendQueueScheduler(std::max(QThread::idealThreadCount(), 1));
+    return *scheduler;
+}
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) {
+    for (int i = 0; i < numThreads; ++i) {
+        auto worker = std::unique_ptr<Worker>(new Worker(*this));
+        worker->setObjectName("Networking: SendQueue " + QString::number(i)); // Name thread for easier debug
+        worker->start();
+        _workers.push_back(std::move(worker));
+    }
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& state = _queues[queue];
+        schedule(queue, state, p_high_resolution_clock::now());
+    }
+    _entriesCondition.notify_one();
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+
+    if (it->second.isServicing) {
+        // the servicing thread erases the queue once it is done with it
+        it->second.isRemoved = true;
+        _servicedCondition.wait(lock, [&] { return _queues.find(queue) == _queues.end(); });
+    } else {
+        // its heap entries are now stale, and will be skipped
+        _queues.erase(it);
+    }
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _queues.find(queue);
+        if (it == _queues.end()) {
+            return;
+        }
+
+        auto& state = it->second;
+        if (state.isServicing) {
+            // re-scheduled for now once serviced if it is then waiting, so that this wake is not lost
+            state.isWoken = true;
+            return;
+        }
+
+        if (!state.isWaiting) {
+            return;
+        }
+
+        auto now = p_high_resolution_clock::now();
+        if (state.nextTime <= now) {
+            return;
+        }
+
+        schedule(queue, state, now);
+    }
+    _entriesCondition.notify_one();
+}
+
+void SendQueueScheduler::schedule(SendQueue* queue, QueueState& state, TimePoint time) {
+    state.nextTime = time;
+    state.generation = _nextGeneration++;
+
+    _entries.push_back({ time, state.generation, queue });
+    std::push_heap(_entries.begin(), _entries.end());
+}
+
+void SendQueueScheduler::runWorker() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // the workers run until the process exits, along with the scheduler
+    for (;;) {
+        if (_entries.empty()) {
+            _entriesCondition.wait(lock);
+            continue;
+        }
+
+        Entry entry = _entries.front();
+
+        auto it = _queues.find(entry.queue);
+        if (it == _queues.end() || it->second.generation != entry.generation) {
+            // the queue was removed or re-scheduled since this entry was pushed
+            std::pop_heap(_entries.begin(), _entries.end());
+            _entries.pop_back();
+            continue;
+        }
+
+        if (entry.time > p_high_resolution_clock::now()) {
+            _entriesCondition.wait_until(lock, entry.time);
+            continue;
+        }
+
+        std::pop_heap(_entries.begin(), _entries.end());
+        _entries.pop_back();
+
+        it->second.isServicing = true;
+        it->second.isWoken = false;
+
+        lock.unlock();
+        auto nextTime = entry.queue->service();
+        bool isWaiting = entry.queue->isWaiting();
+        lock.lock();
+
+        // the queue cannot have been erased while it was being serviced
+        auto& state = _queues[entry.queue];
+        state.isServicing = false;
+        state.isWaiting = isWaiting;
+
+        if (state.isRemoved || nextTime == STOPPED) {
+            _queues.erase(entry.queue);
+            _servicedCondition.notify_all();
+            continue;
+        }
+
+        if (state.isWoken && state.isWaiting) {
+            nextTime = std::min(nextTime, p_high_resolution_clock::now());
+        }
+
+        schedule(entry.queue, state, nextTime);
+
+        if (_entries.size() > 1) {
+            // another thread may be needed for the queues behind this one
+            _entriesCondition.notify_one();
+        }
+    }
+}
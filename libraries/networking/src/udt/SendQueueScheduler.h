@@ -0,0 +1,99 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QThread>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Services all SendQueues from a fixed pool of threads
+//   Each queue is kept in a heap keyed by the time it next wants to send, and is serviced by one thread at a time.
+//   A queue is woken early (re-keyed to now) when it is given packets, ACKs, NAKs, or told to stop.
+//   The instance is never destroyed, so that queues outliving static teardown can still remove themselves.
+class SendQueueScheduler {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    // returned by SendQueue::service when the queue no longer needs servicing
+    static const TimePoint STOPPED;
+
+    static SendQueueScheduler& getInstance();
+
+    // schedules the queue to be serviced now
+    void add(SendQueue* queue);
+
+    // unschedules the queue, waiting for it to finish being serviced if it is
+    void remove(SendQueue* queue);
+
+    // services the queue as soon as possible if it is waiting (no-op if it is pacing, stopped or removed)
+    void wake(SendQueue* queue);
+
+private:
+    class Worker : public QThread {
+    public:
+        Worker(SendQueueScheduler& scheduler) : _scheduler(scheduler) {}
+    protected:
+        void run() override { _scheduler.runWorker(); }
+    private:
+        SendQueueScheduler& _scheduler;
+    };
+
+    struct QueueState {
+        TimePoint nextTime;
+        uint64_t generation;
+        bool isServicing { false };
+        bool isWaiting { true };
+        bool isWoken { false };
+        bool isRemoved { false };
+    };
+
+    struct Entry {
+        TimePoint time;
+        uint64_t generation;
+        SendQueue* queue;
+
+        // inverted, for a min-heap
+        bool operator<(const Entry& other) const { return time > other.time; }
+    };
+
+    SendQueueScheduler(int numThreads);
+
+    void runWorker();
+
+    // requires _mutex
+    void schedule(SendQueue* queue, QueueState& state, TimePoint time);
+
+    std::mutex _mutex;
+    std::condition_variable _entriesCondition;
+    std::condition_variable _servicedCondition;
+
+    std::unordered_map<SendQueue*, QueueState> _queues;
+    std::vector<Entry> _entries; // heap, with stale entries skipped by generation
+    uint64_t _nextGeneration { 0 };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
@@ -15,6 +15,12 @@
 #include <sys/socket.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
@@ -55,6 +61,9 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
 }
 
+// defined here, where the datagram batch is a complete type
+Socket::~Socket() = default;
+
 void Socket::bind(const QHostAddress& address, quint16 port) {
     _udpSocket.bind(address, port);
 
@@ -358,65 +367,154 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+
+#if defined(Q_OS_LINUX)
+        // the first datagram is always read through Qt, so that the state of its read notifier is kept current,
+        // the rest of the queue is then drained in batches
+        readDatagramBatches();
+#endif
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+#if defined(Q_OS_LINUX)
+struct Socket::DatagramBatch {
+    std::unique_ptr<char[]> buffers[DATAGRAM_BATCH_SIZE];
+    sockaddr_storage addresses[DATAGRAM_BATCH_SIZE];
+    iovec vectors[DATAGRAM_BATCH_SIZE];
+    mmsghdr headers[DATAGRAM_BATCH_SIZE];
+};
+
+void Socket::readDatagramBatches() {
+    static const QString DEBUG_FLAG("HIFI_DISABLE_BATCHED_DATAGRAM_READS");
+    static bool disableBatchedReads = QProcessEnvironment::systemEnvironment().contains(DEBUG_FLAG);
+
+    if (disableBatchedReads) {
+        return;
+    }
+
+    if (!_datagramBatch) {
+        _datagramBatch.reset(new DatagramBatch());
+    }
+    auto& batch = *_datagramBatch;
+
+    int numRead = DATAGRAM_BATCH_SIZE;
+    while (numRead == DATAGRAM_BATCH_SIZE) {
+
+        // buffers handed off to packets by the previous batch are replaced, the others are re-used
+        for (int i = 0; i < DATAGRAM_BATCH_SIZE; ++i) {
+            if (!batch.buffers[i]) {
+                batch.buffers[i].reset(new char[MAX_PACKET_SIZE]);
             }
 
-            continue;
+            batch.vectors[i].iov_base = batch.buffers[i].get();
+            batch.vectors[i].iov_len = MAX_PACKET_SIZE;
+
+            auto& header = batch.headers[i].msg_hdr;
+            header.msg_name = &batch.addresses[i];
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_iov = &batch.vectors[i];
+            header.msg_iovlen = 1;
+            header.msg_control = nullptr;
+            header.msg_controllen = 0;
+            header.msg_flags = 0;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        // handlers may have re-bound the socket, so the descriptor is fetched for each batch
+        auto socketDescriptor = _udpSocket.socketDescriptor();
+        if (socketDescriptor == -1) {
+            return;
+        }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        numRead = recvmmsg(socketDescriptor, batch.headers, DATAGRAM_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (numRead <= 0) {
+            // nothing left to read (or an error, which Qt will report on its next read)
+            return;
+        }
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr);
+        _readyReadBackupTimer->start();
+
+        auto receiveTime = p_high_resolution_clock::now();
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+        for (int i = 0; i < numRead; ++i) {
+            qint64 sizeRead = batch.headers[i].msg_len;
+
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&batch.addresses[i]));
+
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            if (sizeRead <= 0 || (batch.headers[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                // empty, or larger than any packet we send - drop it
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
-
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
-
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
-                        continue;
-                    }
+            processDatagram(std::move(batch.buffers[i]), sizeRead, senderSockAddr, receiveTime);
+        }
+    }
+}
+#endif
+
+void Socket::processDatagram(std::unique_ptr<char[]> buffer, qint64 packetSizeWithHeader,
+                             const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+                auto connection = findOrCreateConnection(senderSockAddr);
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
+                    return;
                 }
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
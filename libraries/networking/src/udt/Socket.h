@@ -55,6 +55,7 @@ public:
     using StatsVector = std::vector<std::pair<HifiSockAddr, ConnectionStats::Stats>>;
     
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort() const { return _udpSocket.localPort(); }
     
@@ -109,6 +110,12 @@ private slots:
 
 private:
     void setSystemBufferSizes();
+    void processDatagram(std::unique_ptr<char[]> buffer, qint64 packetSizeWithHeader,
+                         const HifiSockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime);
+#if defined(Q_OS_LINUX)
+    // reads the datagrams left pending after a readyRead with recvmmsg, up to DATAGRAM_BATCH_SIZE per call
+    void readDatagramBatches();
+#endif
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr);
     bool socketMatchesNodeOrDomain(const HifiSockAddr& sockAddr);
    
@@ -148,6 +155,12 @@ private:
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     HifiSockAddr _lastPacketSockAddr;
+
+#if defined(Q_OS_LINUX)
+    static const int DATAGRAM_BATCH_SIZE = 64;
+    struct DatagramBatch;
+    std::unique_ptr<DatagramBatch> _datagramBatch;
+#endif
     
     friend UDTTest;
 };
@@ -51,7 +51,7 @@
 #include "OctreeUtils.h"
 
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -1625,6 +1625,10 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith(".bin")) {
+        return readFromBinaryFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -1877,6 +1881,8 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin" && !element) {
+        success = writeToBinaryFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -1884,10 +1890,27 @@ bool Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
 }
 
 bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element, bool doGzip) {
-    QVariantMap entityDescription;
-
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
+    QByteArray jsonDataForFile;
+    if (!writeToJSON(jsonDataForFile, element, doGzip)) {
+        return false;
+    }
+
+    QFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        success = persistFile.write(jsonDataForFile) != -1;
+    } else {
+        qCritical("Could not write to JSON description of entities.");
+    }
+
+    return success;
+}
+
+bool Octree::writeToJSON(QByteArray& jsonDataForFile, OctreeElementPointer element, bool doGzip) {
+    QVariantMap entityDescription;
+
     OctreeElementPointer top;
     if (element) {
         top = element;
@@ -1909,7 +1932,6 @@ bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
 
     // convert the QVariantMap to JSON
     QByteArray jsonData = QJsonDocument::fromVariant(entityDescription).toJson();
-    QByteArray jsonDataForFile;
 
     if (doGzip) {
         if (!gzip(jsonData, jsonDataForFile, -1)) {
@@ -1920,15 +1942,7 @@ bool Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
         jsonDataForFile = jsonData;
     }
 
-    QFile persistFile(fileName);
-    bool success = false;
-    if (persistFile.open(QIODevice::WriteOnly)) {
-        success = persistFile.write(jsonDataForFile) != -1;
-    } else {
-        qCritical("Could not write to JSON description of entities.");
-    }
-
-    return success;
+    return true;
 }
 
 unsigned long Octree::getOctreeElementsCount() {
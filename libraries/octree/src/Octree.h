@@ -295,9 +295,13 @@ public:
     // Octree exporters
     bool writeToFile(const char* filename, OctreeElementPointer element = NULL, QString persistAsFileType = "json.gz");
     bool writeToJSONFile(const char* filename, OctreeElementPointer element = NULL, bool doGzip = false);
+    bool writeToJSON(QByteArray& jsonDataForFile, OctreeElementPointer element = NULL, bool doGzip = false);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
 
+    // the binary persist format is implemented by the octrees that support it
+    virtual bool writeToBinaryFile(const char* fileName) { return false; }
+
     // Octree importers
     bool readFromFile(const char* filename);
     bool readFromURL(const QString& url); // will support file urls as well...
@@ -306,6 +310,7 @@ public:
     bool readJSONFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    virtual bool readFromBinaryFile(const QString& fileName) { return false; }
 
     unsigned long getOctreeElementsCount();
 
@@ -59,7 +59,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == "bin") {
         return "application/zip";
     }
     return "";
@@ -148,12 +148,19 @@ bool OctreePersistThread::process() {
             QString lockFileName = _filename + ".lock";
             std::ifstream lockFile(qPrintable(lockFileName), std::ios::in | std::ios::binary | std::ios::ate);
             if (lockFile.is_open()) {
-                qCDebug(octree) << "WARNING: Octree lock file detected at startup:" << lockFileName
-                    << "-- Attempting to restore from previous backup file.";
+                if (_persistAsFileType == "bin") {
+                    // the binary file is never left half written, a crash while appending to its log only cuts
+                    // the last record short, and the reader stops before it. The backup would lose more.
+                    qCDebug(octree) << "WARNING: Octree lock file detected at startup:" << lockFileName
+                        << "-- Ignoring it, the binary persist file does not use it.";
+                } else {
+                    qCDebug(octree) << "WARNING: Octree lock file detected at startup:" << lockFileName
+                        << "-- Attempting to restore from previous backup file.";
 
-                // This is where we should attempt to find the most recent backup and restore from
-                // that file as our persist file.
-                restoreFromMostRecentBackup();
+                    // This is where we should attempt to find the most recent backup and restore from
+                    // that file as our persist file.
+                    restoreFromMostRecentBackup();
+                }
 
                 lockFile.close();
                 qCDebug(octree) << "Loading Octree... lock file closed:" << lockFileName;
@@ -161,7 +168,17 @@ bool OctreePersistThread::process() {
                 qCDebug(octree) << "Loading Octree... lock file removed:" << lockFileName;
             }
 
-            persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+            QString fileToRead = _filename;
+            if (_persistAsFileType == "bin" && !QFile::exists(_filename)) {
+                // switching to the binary format, start from the gzipped JSON file it replaces
+                QString jsonFileName = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) + ".json.gz";
+                if (QFile::exists(jsonFileName)) {
+                    qCDebug(octree) << "binary persist file does not exist, loading" << jsonFileName << "instead";
+                    fileToRead = jsonFileName;
+                }
+            }
+
+            persistantFileRead = _tree->readFromFile(qPrintable(fileToRead.toLocal8Bit()));
             _tree->pruneTree();
         });
 
@@ -244,6 +261,14 @@ void OctreePersistThread::aboutToFinish() {
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (_persistAsFileType == "bin") {
+        // the binary file is only meant for the server, export the current content as gzipped JSON instead
+        _tree->withReadLock([&] {
+            _tree->writeToJSON(fileContents, NULL, true);
+        });
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -265,6 +290,16 @@ void OctreePersistThread::persist() {
         qCDebug(octree) << "persist operation DONE with backup...";
 
 
+        if (_persistAsFileType == "bin") {
+            // binary snapshots replace the file atomically, and the log survives a crash while appending to it,
+            // so there is no lock file to leave behind
+            _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+            time(&_lastPersistTime);
+            _tree->clearDirtyBit(); // tree is clean after saving
+            qCDebug(octree) << "DONE saving Octree to file...";
+            return;
+        }
+
         // create our "lock" file to indicate we're saving.
         QString lockFileName = _filename + ".lock";
         std::ofstream lockFile(qPrintable(lockFileName), std::ios::out|std::ios::binary);
@@ -110,9 +110,9 @@ public:
 
     bool maybeStartBlender();
 
-    /// Sets blended vertices computed in a separate thread.
+    /// Sets blended vertices computed in a separate thread, laid out as by PackedBlendshapes.
     void setBlendedVertices(int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
+        const QVector<glm::vec3>& blendedVertices);
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isGeometryLoaded(); }
 
@@ -427,7 +427,7 @@ public:
 
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, const Geometry::WeakPointer& geometry,
-        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
+        const QVector<glm::vec3>& blendedVertices);
 
 private:
     using Mutex = std::mutex;
@@ -2407,6 +2407,10 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // only the outermost entity is charged for nested calls
+    bool isTimed = _context == ENTITY_SERVER_SCRIPT && !entityID.isNull() && oldIdentifier.isNull();
+    quint64 startTime = isTimed ? usecTimestampNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2418,6 +2422,18 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    if (isTimed) {
+        std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+        _entityScriptExecutionTimes[entityID] += usecTimestampNow() - startTime;
+    }
+}
+
+QHash<EntityItemID, quint64> ScriptEngine::takeEntityScriptExecutionTimes() {
+    QHash<EntityItemID, quint64> executionTimes;
+    std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+    executionTimes.swap(_entityScriptExecutionTimes);
+    return executionTimes;
 }
 
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
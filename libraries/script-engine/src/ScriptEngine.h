@@ -12,6 +12,7 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <mutex>
 #include <vector>
 
 #include <QtCore/QObject>
@@ -225,6 +226,9 @@ public:
     int getNumRunningEntityScripts() const;
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
 
+    // returns the usecs spent running each entity server script since the last call, and resets them
+    QHash<EntityItemID, quint64> takeEntityScriptExecutionTimes();
+
 public slots:
     void callAnimationStateHandler(QScriptValue callback, AnimVariantMap parameters, QStringList names, bool useNames, AnimVariantResultHandler resultHandler);
     void updateMemoryCost(const qint64&);
@@ -314,6 +318,9 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    std::mutex _entityScriptExecutionTimesLock;
+    QHash<EntityItemID, quint64> _entityScriptExecutionTimes;
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
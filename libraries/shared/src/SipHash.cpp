@@ -0,0 +1,82 @@
+//
+//  SipHash.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SipHash.h"
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// reads bytes little endian, whatever the host endianness and alignment
+static inline uint64_t readLittleEndian(const uint8_t* bytes, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value |= (uint64_t)bytes[i] << (8 * i);
+    }
+    return value;
+}
+
+static inline void writeLittleEndian(uint64_t value, uint8_t* bytes) {
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+#define SIP_ROUND                                                           \
+    do {                                                                    \
+        v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32); \
+        v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;                        \
+        v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;                        \
+        v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32); \
+    } while (0)
+
+void sipHash128(uint64_t key0, uint64_t key1, const void* data, size_t size, uint8_t hash[NUM_BYTES_SIP_HASH_128]) {
+    uint64_t v0 = key0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = key1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = key0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = key1 ^ 0x7465646279746573ULL;
+
+    // 128-bit output
+    v1 ^= 0xee;
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t* end = bytes + (size - size % sizeof(uint64_t));
+
+    // compression, 2 rounds per 8 bytes
+    for (; bytes != end; bytes += sizeof(uint64_t)) {
+        uint64_t word = readLittleEndian(bytes, sizeof(uint64_t));
+        v3 ^= word;
+        SIP_ROUND;
+        SIP_ROUND;
+        v0 ^= word;
+    }
+
+    // the last bytes along with the length
+    uint64_t last = ((uint64_t)size << 56) | readLittleEndian(bytes, size % sizeof(uint64_t));
+    v3 ^= last;
+    SIP_ROUND;
+    SIP_ROUND;
+    v0 ^= last;
+
+    // finalization, 4 rounds per output word
+    v2 ^= 0xee;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    writeLittleEndian(v0 ^ v1 ^ v2 ^ v3, hash);
+
+    v1 ^= 0xdd;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    SIP_ROUND;
+    writeLittleEndian(v0 ^ v1 ^ v2 ^ v3, hash + sizeof(uint64_t));
+}
@@ -0,0 +1,24 @@
+//
+//  SipHash.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SipHash_h
+#define hifi_SipHash_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+const int NUM_BYTES_SIP_HASH_128 = 16;
+
+// SipHash-2-4 with a 128-bit output (https://131002.net/siphash/)
+//   A keyed hash (MAC) built for short inputs, several times faster than MD5 and with no per-call allocation.
+//   The 128-bit key is given as two 64-bit words, the hash is written little endian.
+void sipHash128(uint64_t key0, uint64_t key1, const void* data, size_t size, uint8_t hash[NUM_BYTES_SIP_HASH_128]);
+
+#endif // hifi_SipHash_h
@@ -0,0 +1,95 @@
+//
+//  ThreadHelpers.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ThreadHelpers.h"
+
+#include <mutex>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include "Finally.h"
+
+// true on the threads of the parallelFor pool
+static thread_local bool isParallelForThread { false };
+
+// A pool of its own, so the loops neither grow the thread count with each caller nor queue behind the
+// long running tasks of the global pool. The calling thread runs a range too, so one core is left out.
+static QThreadPool& getParallelForThreadPool() {
+    static QThreadPool threadPool;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        threadPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
+    });
+    return threadPool;
+}
+
+int getParallelForThreadCount() {
+    if (isParallelForThread) {
+        return 1;
+    }
+    return getParallelForThreadPool().maxThreadCount() + 1;
+}
+
+class ParallelForRange : public QRunnable {
+public:
+    ParallelForRange(std::function<void()> function) : _function(function) {}
+
+    void run() override {
+        isParallelForThread = true;
+        _function();
+        isParallelForThread = false;
+    }
+
+private:
+    std::function<void()> _function;
+};
+
+void parallelForRanges(int count, int countPerRange, const std::function<void(int, int)>& function) {
+    std::mutex exceptionMutex;
+    std::exception_ptr exception;
+    auto runRange = [&](int begin, int end) {
+        try {
+            function(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    };
+
+    QSemaphore rangesDone;
+    int numQueuedRanges = 0;
+    {
+        // the queued ranges reference this frame, wait for them even if queueing throws
+        Finally waitForRanges([&] {
+            rangesDone.acquire(numQueuedRanges);
+        });
+
+        auto& threadPool = getParallelForThreadPool();
+        for (int begin = countPerRange; begin < count; begin += countPerRange) {
+            int end = std::min(begin + countPerRange, count);
+            threadPool.start(new ParallelForRange([&, begin, end] {
+                runRange(begin, end);
+                rangesDone.release();
+            }));
+            ++numQueuedRanges;
+        }
+        // the calling thread takes the first range
+        runRange(0, countPerRange);
+    }
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
@@ -11,7 +11,10 @@
 #ifndef hifi_ThreadHelpers_h
 #define hifi_ThreadHelpers_h
 
+#include <algorithm>
 #include <exception>
+#include <functional>
+
 #include <QMutex>
 #include <QMutexLocker>
 
@@ -26,4 +29,26 @@ void withLock(QMutex& lock, F function) {
     function();
 }
 
+// Runs function(begin, end) on the ranges of [countPerRange, count), on the shared parallelFor thread pool,
+// and function(0, countPerRange) on the calling thread. Returns once all ranges are done, rethrowing the first exception.
+void parallelForRanges(int count, int countPerRange, const std::function<void(int, int)>& function);
+
+// The number of threads that parallelFor can use, the calling thread included
+// Returns 1 on the parallelFor pool threads, so that nested loops run serially rather than wait on their own pool.
+int getParallelForThreadCount();
+
+// Calls function(begin, end) on contiguous ranges covering [0, count), spread across the cores
+// Ranges are at least minCountPerRange long, small counts run on the calling thread. Returns once all ranges are done.
+// Each queued range costs an allocation, a wake up of a pool thread and a semaphore round trip, a few microseconds,
+// and the calling thread waits for the slowest range. Pick minCountPerRange so that a range runs well past that.
+template <typename F>
+void parallelFor(int count, int minCountPerRange, F function) {
+    int numThreads = std::min(getParallelForThreadCount(), count / std::max(minCountPerRange, 1));
+    if (numThreads <= 1) {
+        function(0, count);
+        return;
+    }
+    parallelForRanges(count, (count + numThreads - 1) / numThreads, function);
+}
+
 #endif
@@ -0,0 +1,116 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <memory>
+#include <random>
+
+#include <AudioHRTF.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+static const int NUM_SOURCES = 16;
+static const int NUM_FRAMES = 200;
+static const int BENCHMARK_FRAMES = 2000;
+
+struct Sources {
+    AudioHRTF hrtfs[NUM_SOURCES];
+    AudioHRTF* pointers[NUM_SOURCES];
+    int16_t samples[NUM_SOURCES][HRTF_BLOCK];
+    int16_t* inputs[NUM_SOURCES];
+    float azimuths[NUM_SOURCES];
+    float distances[NUM_SOURCES];
+    float gains[NUM_SOURCES];
+
+    Sources() {
+        for (int i = 0; i < NUM_SOURCES; i++) {
+            pointers[i] = &hrtfs[i];
+            inputs[i] = samples[i];
+            azimuths[i] = i * (TWO_PI / NUM_SOURCES);
+            distances[i] = 1.0f + i;
+            gains[i] = 1.0f / (1.0f + i);
+        }
+    }
+};
+
+// move some of the sources every frame, so that both batched paths are exercised
+static void updateSources(Sources& sources, int frame, std::mt19937& generator) {
+    std::uniform_int_distribution<int> sample(-8192, 8192);
+
+    for (int i = 0; i < NUM_SOURCES; i++) {
+        for (int j = 0; j < HRTF_BLOCK; j++) {
+            sources.samples[i][j] = sample(generator);
+        }
+        if ((frame + i) % 5 == 0) {
+            sources.azimuths[i] += 0.1f;
+        }
+    }
+}
+
+void AudioHRTFTests::testRenderBatch() {
+    std::mt19937 generator;
+
+    // the same sources, rendered one at a time and in a batch
+    auto sources = std::unique_ptr<Sources>(new Sources());
+    auto batchSources = std::unique_ptr<Sources>(new Sources());
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        updateSources(*sources, frame, generator);
+        memcpy(batchSources->samples, sources->samples, sizeof(sources->samples));
+
+        float output[2 * HRTF_BLOCK] = {};
+        float batchOutput[2 * HRTF_BLOCK] = {};
+
+        for (int i = 0; i < NUM_SOURCES; i++) {
+            sources->hrtfs[i].render(sources->inputs[i], output, 0,
+                                     sources->azimuths[i], sources->distances[i], sources->gains[i], HRTF_BLOCK);
+        }
+
+        AudioHRTF::renderBatch(batchSources->pointers, batchSources->inputs, batchOutput, 0,
+                               sources->azimuths, sources->distances, sources->gains, NUM_SOURCES, HRTF_BLOCK);
+
+        // batching must not change the mix
+        for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+            QCOMPARE(batchOutput[i], output[i]);
+        }
+    }
+}
+
+void AudioHRTFTests::benchmarkRenderBatch() {
+    std::mt19937 generator;
+    auto sources = std::unique_ptr<Sources>(new Sources());
+    updateSources(*sources, 1, generator);
+
+    float output[2 * HRTF_BLOCK] = {};
+
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+            for (int i = 0; i < NUM_SOURCES; i++) {
+                sources->hrtfs[i].render(sources->inputs[i], output, 0,
+                                         sources->azimuths[i], sources->distances[i], sources->gains[i], HRTF_BLOCK);
+            }
+        }
+        qDebug() << "render" << (float)timer.nsecsElapsed() / (BENCHMARK_FRAMES * NUM_SOURCES) << "ns/voice";
+    }
+
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+            AudioHRTF::renderBatch(sources->pointers, sources->inputs, output, 0,
+                                   sources->azimuths, sources->distances, sources->gains, NUM_SOURCES, HRTF_BLOCK);
+        }
+        qDebug() << "renderBatch" << (float)timer.nsecsElapsed() / (BENCHMARK_FRAMES * NUM_SOURCES) << "ns/voice";
+    }
+}
@@ -18,6 +18,8 @@
 
 #include <ShapeEntityItem.h>
 #include <EntityItemProperties.h>
+#include <EntityNodeData.h>
+#include <EntityTree.h>
 #include <Octree.h>
 #include <PathUtils.h>
 
@@ -135,6 +137,79 @@ void testPropertyFlags() {
     testPropertyFlags(0xFFFF);
 }
 
+void benchmarkEntityTree() {
+    const int NUM_ENTITIES = 100000;
+    const float DOMAIN_HALF_SIZE = 1000.0f;
+
+    auto tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+
+    QVector<EntityItemID> entityIDs;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entityIDs << EntityItemID(QUuid::createUuid());
+    }
+
+    StopWatch watch;
+
+    watch.start();
+    tree->withWriteLock([&] {
+        foreach (const EntityItemID& entityID, entityIDs) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3(randFloatInRange(-DOMAIN_HALF_SIZE, DOMAIN_HALF_SIZE),
+                                             randFloatInRange(-DOMAIN_HALF_SIZE, DOMAIN_HALF_SIZE),
+                                             randFloatInRange(-DOMAIN_HALF_SIZE, DOMAIN_HALF_SIZE)));
+            properties.setDimensions(glm::vec3(0.1f));
+            tree->addEntity(entityID, properties);
+        }
+    });
+    watch.stop();
+    qDebug() << "insert" << NUM_ENTITIES << "entities:" << watch.getLast() << "usecs";
+
+    int found = 0;
+    watch.start();
+    tree->withReadLock([&] {
+        foreach (const EntityItemID& entityID, entityIDs) {
+            if (tree->findEntityByEntityItemID(entityID)) {
+                ++found;
+            }
+        }
+    });
+    watch.stop();
+    Q_ASSERT(found == NUM_ENTITIES);
+    qDebug() << "find" << found << "entities:" << watch.getLast() << "usecs";
+
+    // encode the whole tree for one client, as for its first scene
+    EntityNodeData nodeData;
+    nodeData.setUsesFrustum(false);
+    OctreePacketData packetData(true);
+    OctreeElementBag bag;
+    int packets = 0;
+    watch.start();
+    tree->withReadLock([&] {
+        EncodeBitstreamParams params(INT_MAX, WANT_EXISTS_BITS, DONT_CHOP, false, NO_BOUNDARY_ADJUST,
+                                     DEFAULT_OCTREE_SIZE_SCALE, true, IGNORE_JURISDICTION_MAP, &nodeData);
+        bag.insert(tree->getRoot());
+        while (!bag.isEmpty()) {
+            packetData.reset();
+            tree->encodeTreeBitstream(bag.extract(), &packetData, bag, params);
+            ++packets;
+        }
+    });
+    watch.stop();
+    qDebug() << "encode" << NUM_ENTITIES << "entities in" << packets << "packets:" << watch.getLast() << "usecs";
+    tree->releaseSceneEncodeData(&nodeData.extraEncodeData);
+
+    QSet<EntityItemID> entityIDsToDelete = entityIDs.toList().toSet();
+    watch.start();
+    tree->withWriteLock([&] {
+        tree->deleteEntities(entityIDsToDelete, true, true);
+    });
+    watch.stop();
+    qDebug() << "remove" << NUM_ENTITIES << "entities:" << watch.getLast() << "usecs";
+}
+
 int main(int argc, char** argv) {
     QCoreApplication app(argc, argv);
     {
@@ -152,6 +227,8 @@ int main(int argc, char** argv) {
     }
     DependencyManager::set<NodeList>(NodeType::Unassigned);
 
+    benchmarkEntityTree();
+
     QFile file(getTestResourceDir() + "packet.bin");
     if (!file.open(QIODevice::ReadOnly)) return -1;
     QByteArray packet = file.readAll();
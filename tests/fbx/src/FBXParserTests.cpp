@@ -0,0 +1,227 @@
+//
+//  FBXParserTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXParserTests.h"
+
+#include <cmath>
+
+#include <QtCore/QBuffer>
+
+#include <FBXReader.h>
+
+QTEST_MAIN(FBXParserTests)
+
+// Writes the records of a binary FBX with the 32 bit node headers of the versions before FBX 2016
+class BinaryFBXWriter {
+public:
+    BinaryFBXWriter() {
+        const quint32 FBX_VERSION = 7400;
+        _data.append("Kaydara FBX Binary  ", 20);
+        _data.append('\0');
+        _data.append('\x1a');
+        _data.append('\0');
+        appendValue(_data, FBX_VERSION);
+    }
+
+    void beginNode(const QByteArray& name, const QByteArray& properties = QByteArray(), quint32 propertyCount = 0) {
+        _nodeOffsets.push_back(_data.size());
+        appendValue<quint32>(_data, 0); // end offset, set by endNode()
+        appendValue<quint32>(_data, propertyCount);
+        appendValue<quint32>(_data, properties.size());
+        appendValue<quint8>(_data, (quint8)name.size());
+        _data.append(name);
+        _data.append(properties);
+    }
+
+    void endNode(bool hasChildren) {
+        if (hasChildren) {
+            appendNullRecord();
+        }
+        quint32 endOffset = _data.size();
+        memcpy(_data.data() + _nodeOffsets.back(), &endOffset, sizeof(endOffset));
+        _nodeOffsets.pop_back();
+    }
+
+    QByteArray finish() {
+        appendNullRecord();
+        return _data;
+    }
+
+    template<class T> static void appendValue(QByteArray& data, T value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static QByteArray intProperty(qint32 value) {
+        QByteArray property("I");
+        appendValue(property, value);
+        return property;
+    }
+
+    static QByteArray stringProperty(const QByteArray& value) {
+        QByteArray property("S");
+        appendValue<quint32>(property, value.size());
+        property.append(value);
+        return property;
+    }
+
+    template<class T> static QByteArray arrayProperty(char type, const QVector<T>& values, bool deflate) {
+        QByteArray contents(reinterpret_cast<const char*>(values.constData()), values.size() * (int)sizeof(T));
+        if (deflate) {
+            // qCompress writes a zlib stream, after the big endian length that FBX does not store
+            contents = qCompress(contents).mid(sizeof(quint32));
+        }
+        QByteArray property(1, type);
+        appendValue<quint32>(property, values.size());
+        appendValue<quint32>(property, deflate ? 1 : 0);
+        appendValue<quint32>(property, contents.size());
+        property.append(contents);
+        return property;
+    }
+
+private:
+    void appendNullRecord() {
+        const int NULL_RECORD_SIZE = 13;
+        _data.append(QByteArray(NULL_RECORD_SIZE, '\0'));
+    }
+
+    QByteArray _data;
+    std::vector<int> _nodeOffsets;
+};
+
+static FBXNode parseFBX(QByteArray fbx) {
+    QBuffer buffer(&fbx);
+    buffer.open(QIODevice::ReadOnly);
+    return FBXReader::parseFBX(&buffer);
+}
+
+// The layout of a skinned mesh, with the vertex and index counts of a detailed avatar
+static QByteArray createAvatarSizedFBX() {
+    const int NUM_VERTICES = 60000;
+    const int NUM_TRIANGLES = 100000;
+    const int NUM_MODELS = 200;
+
+    QVector<double> vertices;
+    QVector<double> normals;
+    for (int i = 0; i < NUM_VERTICES * 3; i++) {
+        vertices.append(sin(i * 0.01) * 0.5);
+        normals.append(cos(i * 0.03));
+    }
+    QVector<double> texCoords;
+    for (int i = 0; i < NUM_VERTICES * 2; i++) {
+        texCoords.append((double)(i % 1024) / 1024.0);
+    }
+    QVector<qint32> indices;
+    for (int i = 0; i < NUM_TRIANGLES * 3; i++) {
+        int index = (i * 7) % NUM_VERTICES;
+        // the last index of each polygon is stored negated, minus one
+        indices.append((i % 3 == 2) ? -index - 1 : index);
+    }
+
+    BinaryFBXWriter writer;
+    writer.beginNode("Objects");
+    writer.beginNode("Geometry", BinaryFBXWriter::intProperty(1) + BinaryFBXWriter::stringProperty("Geometry::Body"), 2);
+    writer.beginNode("Vertices", BinaryFBXWriter::arrayProperty('d', vertices, true), 1);
+    writer.endNode(false);
+    writer.beginNode("PolygonVertexIndex", BinaryFBXWriter::arrayProperty('i', indices, true), 1);
+    writer.endNode(false);
+    writer.beginNode("LayerElementNormal");
+    writer.beginNode("Normals", BinaryFBXWriter::arrayProperty('d', normals, true), 1);
+    writer.endNode(false);
+    writer.endNode(true);
+    writer.beginNode("LayerElementUV");
+    writer.beginNode("UV", BinaryFBXWriter::arrayProperty('d', texCoords, true), 1);
+    writer.endNode(false);
+    writer.endNode(true);
+    writer.endNode(true);
+    for (int i = 0; i < NUM_MODELS; i++) {
+        writer.beginNode("Model", BinaryFBXWriter::intProperty(i + 2) + BinaryFBXWriter::stringProperty("Model::Joint"), 2);
+        writer.beginNode("Lcl Translation", BinaryFBXWriter::arrayProperty('d', QVector<double>({ 0.0, 0.1, 0.0 }), false), 1);
+        writer.endNode(false);
+        writer.endNode(true);
+    }
+    writer.endNode(true);
+    return writer.finish();
+}
+
+void FBXParserTests::binaryPropertiesTest() {
+    QVector<double> vertices;
+    for (int i = 0; i < 3000; i++) {
+        vertices.append(i * 0.25);
+    }
+    QVector<qint32> indices;
+    for (int i = 0; i < 1000; i++) {
+        indices.append(i - 500);
+    }
+    QVector<float> weights({ 0.0f, 0.5f, 1.0f });
+    // exporters may write any non zero byte for true
+    QVector<quint8> flags({ 0, 1, 2, 255 });
+
+    BinaryFBXWriter writer;
+    writer.beginNode("Objects");
+    writer.beginNode("Geometry", BinaryFBXWriter::intProperty(42) + BinaryFBXWriter::stringProperty("Geometry::Mesh"), 2);
+    writer.beginNode("Vertices", BinaryFBXWriter::arrayProperty('d', vertices, true), 1);
+    writer.endNode(false);
+    writer.beginNode("PolygonVertexIndex", BinaryFBXWriter::arrayProperty('i', indices, false), 1);
+    writer.endNode(false);
+    writer.beginNode("Weights", BinaryFBXWriter::arrayProperty('f', weights, true), 1);
+    writer.endNode(false);
+    writer.beginNode("Flags", BinaryFBXWriter::arrayProperty('b', flags, false), 1);
+    writer.endNode(false);
+    writer.endNode(true);
+    writer.endNode(true);
+
+    FBXNode top = parseFBX(writer.finish());
+    QCOMPARE(top.children.size(), 1);
+    QCOMPARE(top.children.at(0).name, QByteArray("Objects"));
+    QCOMPARE(top.children.at(0).children.size(), 1);
+
+    const FBXNode& geometry = top.children.at(0).children.at(0);
+    QCOMPARE(geometry.name, QByteArray("Geometry"));
+    QCOMPARE(geometry.properties.size(), 2);
+    QCOMPARE(geometry.properties.at(0).toInt(), 42);
+    QCOMPARE(geometry.properties.at(1).toByteArray(), QByteArray("Geometry::Mesh"));
+
+    QCOMPARE(geometry.children.size(), 4);
+    QCOMPARE(FBXReader::getDoubleVector(geometry.children.at(0)), vertices);
+    QCOMPARE(FBXReader::getIntVector(geometry.children.at(1)), indices);
+    QCOMPARE(FBXReader::getFloatVector(geometry.children.at(2)), weights);
+    QCOMPARE(geometry.children.at(3).properties.at(0).value<QVector<bool>>(), QVector<bool>({ false, true, true, true }));
+}
+
+void FBXParserTests::truncatedArrayTest() {
+    BinaryFBXWriter writer;
+    QByteArray array = BinaryFBXWriter::arrayProperty('d', QVector<double>(1000, 1.0), false);
+    array.truncate(100);
+    writer.beginNode("Vertices", array, 1);
+    writer.endNode(false);
+
+    QVERIFY_EXCEPTION_THROWN(parseFBX(writer.finish()), QString);
+}
+
+void FBXParserTests::benchmarkParseBinary_data() {
+    QTest::addColumn<QByteArray>("fbx");
+
+    QTest::newRow("avatar sized") << createAvatarSizedFBX();
+
+    QString filename = QProcessEnvironment::systemEnvironment().value("HIFI_FBX_BENCHMARK_FILE");
+    QFile file(filename);
+    if (!filename.isEmpty() && file.open(QIODevice::ReadOnly)) {
+        QTest::newRow(qPrintable(QFileInfo(filename).fileName())) << file.readAll();
+    }
+}
+
+void FBXParserTests::benchmarkParseBinary() {
+    QFETCH(QByteArray, fbx);
+
+    QBENCHMARK {
+        FBXNode top = parseFBX(fbx);
+        QVERIFY(!top.children.isEmpty());
+    }
+}
@@ -0,0 +1,32 @@
+//
+//  FBXParserTests.h
+//  tests/fbx/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXParserTests_h
+#define hifi_FBXParserTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class FBXParserTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test the scalar, string and array properties of a binary FBX, with raw and deflated arrays
+    void binaryPropertiesTest();
+
+    // Test a binary FBX with an array claiming more data than the file holds is rejected
+    void truncatedArrayTest();
+
+    // Time the parsing of an avatar sized binary FBX, and of the file named by HIFI_FBX_BENCHMARK_FILE if set
+    void benchmarkParseBinary_data();
+    void benchmarkParseBinary();
+};
+
+#endif // hifi_FBXParserTests_h
@@ -0,0 +1,226 @@
+//
+//  TextureCompressionTests.cpp
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureCompressionTests.h"
+
+#include <array>
+#include <cstdlib>
+
+#include <model/TextureCompression.h>
+
+QTEST_MAIN(TextureCompressionTests)
+
+using namespace model;
+
+static const int BLOCK_NUM_TEXELS = 16;
+static const int BC1_BLOCK_SIZE = 8;
+static const int BC3_BLOCK_SIZE = 16;
+static const int BC4_BLOCK_SIZE = 8;
+
+// the largest error of a channel rounded to 5 and 6 bits, and expanded back to 8 bits
+static const int MAX_RGB565_ERROR[3] = { 4, 2, 4 };
+
+// the largest error of a value between the BC4 end points, half a step of the palette and its rounding
+static int evalMaxBC4Error(int minValue, int maxValue) {
+    return (maxValue - minValue) / 14 + 1;
+}
+
+using Colors = std::array<QRgb, BLOCK_NUM_TEXELS>;
+using Values = std::array<int, BLOCK_NUM_TEXELS>;
+
+// A reference decoder of the blocks, as the S3TC and RGTC extensions specify them
+static QRgb unpackRGB565(uint16_t packed) {
+    int r = (packed >> 11) & 0x1F;
+    int g = (packed >> 5) & 0x3F;
+    int b = packed & 0x1F;
+    return qRgb((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+static QRgb mixColors(QRgb color0, int weight0, QRgb color1, int weight1) {
+    int sum = weight0 + weight1;
+    return qRgb((qRed(color0) * weight0 + qRed(color1) * weight1) / sum,
+                (qGreen(color0) * weight0 + qGreen(color1) * weight1) / sum,
+                (qBlue(color0) * weight0 + qBlue(color1) * weight1) / sum);
+}
+
+static Colors decodeBC1(const uint8_t* block) {
+    uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+    uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+    QRgb palette[4];
+    palette[0] = unpackRGB565(color0);
+    palette[1] = unpackRGB565(color1);
+    if (color0 > color1) {
+        palette[2] = mixColors(palette[0], 2, palette[1], 1);
+        palette[3] = mixColors(palette[0], 1, palette[1], 2);
+    } else {
+        palette[2] = mixColors(palette[0], 1, palette[1], 1);
+        palette[3] = qRgba(0, 0, 0, 0);
+    }
+
+    uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t)block[7] << 24);
+    Colors colors;
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        colors[i] = palette[(indices >> (2 * i)) & 0x3];
+    }
+    return colors;
+}
+
+static Values decodeBC4(const uint8_t* block) {
+    int value0 = block[0];
+    int value1 = block[1];
+    int palette[8];
+    palette[0] = value0;
+    palette[1] = value1;
+    if (value0 > value1) {
+        for (int index = 2; index < 8; ++index) {
+            palette[index] = ((8 - index) * value0 + (index - 1) * value1) / 7;
+        }
+    } else {
+        for (int index = 2; index < 6; ++index) {
+            palette[index] = ((6 - index) * value0 + (index - 1) * value1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= (uint64_t)block[2 + i] << (8 * i);
+    }
+    Values values;
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        values[i] = palette[(indices >> (3 * i)) & 0x7];
+    }
+    return values;
+}
+
+static bool isColorWithin(QRgb color, QRgb expected, const int maxError[3]) {
+    return std::abs(qRed(color) - qRed(expected)) <= maxError[0] &&
+        std::abs(qGreen(color) - qGreen(expected)) <= maxError[1] &&
+        std::abs(qBlue(color) - qBlue(expected)) <= maxError[2];
+}
+
+static int evalDistance(QRgb color0, QRgb color1) {
+    int red = qRed(color0) - qRed(color1);
+    int green = qGreen(color0) - qGreen(color1);
+    int blue = qBlue(color0) - qBlue(color1);
+    return red * red + green * green + blue * blue;
+}
+
+void TextureCompressionTests::bc1SolidBlocksTest() {
+    // one color per block, 200 in red is 206 once truncated to 5 bits and 198 once rounded
+    const QRgb BLOCK_COLORS[4] = { qRgb(200, 100, 50), qRgb(0, 0, 0), qRgb(255, 255, 255), qRgb(17, 130, 240) };
+    QImage image(8, 8, QImage::Format_ARGB32);
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            image.setPixel(x, y, BLOCK_COLORS[(y / 4) * 2 + x / 4]);
+        }
+    }
+
+    auto blocks = compressImage(image, gpu::Element::COLOR_COMPRESSED_SRGB);
+    QCOMPARE(blocks.size(), (size_t)(4 * BC1_BLOCK_SIZE));
+    for (int block = 0; block < 4; ++block) {
+        auto colors = decodeBC1(blocks.data() + block * BC1_BLOCK_SIZE);
+        for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+            QVERIFY(isColorWithin(colors[i], BLOCK_COLORS[block], MAX_RGB565_ERROR));
+        }
+    }
+}
+
+void TextureCompressionTests::bc1TwoColorsTest() {
+    const QRgb ORANGE = qRgb(255, 128, 0);
+    const QRgb BLUE = qRgb(0, 64, 255);
+    // an irregular pattern, so that each texel index has to land in its own bits
+    const int PATTERN = 0xB2C5;
+    QImage image(4, 4, QImage::Format_ARGB32);
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        image.setPixel(i % 4, i / 4, ((PATTERN >> i) & 1) ? ORANGE : BLUE);
+    }
+
+    auto blocks = compressImage(image, gpu::Element::COLOR_COMPRESSED_SRGB);
+    QCOMPARE(blocks.size(), (size_t)BC1_BLOCK_SIZE);
+    // the end points must select the 4 colors mode, the 3 colors one has a transparent black
+    uint16_t color0 = (uint16_t)(blocks[0] | (blocks[1] << 8));
+    uint16_t color1 = (uint16_t)(blocks[2] | (blocks[3] << 8));
+    QVERIFY(color0 > color1);
+
+    auto colors = decodeBC1(blocks.data());
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        QRgb expected = ((PATTERN >> i) & 1) ? ORANGE : BLUE;
+        QRgb other = ((PATTERN >> i) & 1) ? BLUE : ORANGE;
+        QVERIFY(evalDistance(colors[i], expected) < evalDistance(colors[i], other));
+    }
+}
+
+void TextureCompressionTests::bc3AlphaTest() {
+    const QRgb COLOR = qRgb(17, 130, 240);
+    QImage image(4, 4, QImage::Format_ARGB32);
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        image.setPixel(i % 4, i / 4, qRgba(qRed(COLOR), qGreen(COLOR), qBlue(COLOR), i * 17));
+    }
+
+    auto blocks = compressImage(image, gpu::Element::COLOR_COMPRESSED_SRGBA);
+    QCOMPARE(blocks.size(), (size_t)BC3_BLOCK_SIZE);
+
+    auto alphas = decodeBC4(blocks.data());
+    const int maxError = evalMaxBC4Error(0, 255);
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        QVERIFY(std::abs(alphas[i] - i * 17) <= maxError);
+    }
+
+    auto colors = decodeBC1(blocks.data() + BC4_BLOCK_SIZE);
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        QVERIFY(isColorWithin(colors[i], COLOR, MAX_RGB565_ERROR));
+    }
+}
+
+void TextureCompressionTests::bc4GradientTest() {
+    const int MIN_VALUE = 40;
+    const int MAX_VALUE = 220;
+    QImage image(4, 4, QImage::Format_Grayscale8);
+    Values expected;
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        expected[i] = MIN_VALUE + (MAX_VALUE - MIN_VALUE) * i / (BLOCK_NUM_TEXELS - 1);
+        image.scanLine(i / 4)[i % 4] = (uchar)expected[i];
+    }
+
+    auto blocks = compressImage(image, gpu::Element::COLOR_COMPRESSED_RED);
+    QCOMPARE(blocks.size(), (size_t)BC4_BLOCK_SIZE);
+
+    auto values = decodeBC4(blocks.data());
+    QCOMPARE(values[0], MIN_VALUE);
+    QCOMPARE(values[BLOCK_NUM_TEXELS - 1], MAX_VALUE);
+    const int maxError = evalMaxBC4Error(MIN_VALUE, MAX_VALUE);
+    for (int i = 0; i < BLOCK_NUM_TEXELS; ++i) {
+        QVERIFY(std::abs(values[i] - expected[i]) <= maxError);
+    }
+}
+
+void TextureCompressionTests::bc4PartialBlocksTest() {
+    // 2x2 blocks, the right and bottom ones only partly covered
+    const int WIDTH = 6;
+    const int HEIGHT = 5;
+    QImage image(WIDTH, HEIGHT, QImage::Format_Grayscale8);
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            image.scanLine(y)[x] = (uchar)((x < 4 ? 0 : 128) + (y < 4 ? 0 : 64));
+        }
+    }
+
+    auto blocks = compressImage(image, gpu::Element::COLOR_COMPRESSED_RED);
+    QCOMPARE(blocks.size(), (size_t)(4 * BC4_BLOCK_SIZE));
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            int block = (y / 4) * 2 + x / 4;
+            auto values = decodeBC4(blocks.data() + block * BC4_BLOCK_SIZE);
+            QCOMPARE(values[(y % 4) * 4 + x % 4], (int)image.constScanLine(y)[x]);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+//
+//  TextureCompressionTests.h
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureCompressionTests_h
+#define hifi_TextureCompressionTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TextureCompressionTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test solid BC1 blocks decode to their color, rounded to RGB565, in the order of the image
+    void bc1SolidBlocksTest();
+
+    // Test each texel of a two colors BC1 block decodes to the color it was
+    void bc1TwoColorsTest();
+
+    // Test BC3 packs the alpha as a BC4 block followed by the color as a BC1 block
+    void bc3AlphaTest();
+
+    // Test BC4 keeps the end points exactly and the values in between to within half a step of its 8 values
+    void bc4GradientTest();
+
+    // Test the partial blocks on the right and bottom edges of an image are packed too
+    void bc4PartialBlocksTest();
+};
+
+#endif // hifi_TextureCompressionTests_h
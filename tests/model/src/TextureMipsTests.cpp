@@ -0,0 +1,105 @@
+//
+//  TextureMipsTests.cpp
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureMipsTests.h"
+
+#include <model/TextureMips.h>
+
+QTEST_MAIN(TextureMipsTests)
+
+using namespace model;
+
+// black and white texels in a checkerboard, every 2x2 block averages to half the light
+static QImage createCheckerboard(int size) {
+    QImage image(size, size, QImage::Format_ARGB32);
+    for (int y = 0; y < size; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < size; ++x) {
+            line[x] = ((x + y) % 2 == 0) ? qRgba(0, 0, 0, 255) : qRgba(255, 255, 255, 255);
+        }
+    }
+    return image;
+}
+
+void TextureMipsTests::gammaCorrectBoxFilterTest() {
+    QImage image = createCheckerboard(2);
+
+    // half the light of white is 0.5 linear, 188 in sRGB rather than the 128 of averaging the sRGB values
+    const int HALF_LIGHT_SRGB = 188;
+    QImage srgbMip = downsampleImage(image, QSize(1, 1), true);
+    QCOMPARE(srgbMip.size(), QSize(1, 1));
+    QCOMPARE(srgbMip.pixel(0, 0), qRgba(HALF_LIGHT_SRGB, HALF_LIGHT_SRGB, HALF_LIGHT_SRGB, 255));
+
+    const int HALF_LIGHT_LINEAR = 128;
+    QImage linearMip = downsampleImage(image, QSize(1, 1), false);
+    QCOMPARE(linearMip.pixel(0, 0), qRgba(HALF_LIGHT_LINEAR, HALF_LIGHT_LINEAR, HALF_LIGHT_LINEAR, 255));
+}
+
+void TextureMipsTests::alphaWeightedBoxFilterTest() {
+    QImage image(2, 1, QImage::Format_ARGB32);
+    image.setPixel(0, 0, qRgba(255, 0, 0, 0));
+    image.setPixel(1, 0, qRgba(0, 255, 0, 255));
+
+    QImage mip = downsampleImage(image, QSize(1, 1), true);
+    QCOMPARE(mip.pixel(0, 0), qRgba(0, 255, 0, 128));
+}
+
+void TextureMipsTests::threadedBoxFilterTest() {
+    const int SIZE = 1024;
+    QImage image = createCheckerboard(SIZE);
+
+    const int HALF_LIGHT_SRGB = 188;
+    const QRgb HALF_LIGHT = qRgba(HALF_LIGHT_SRGB, HALF_LIGHT_SRGB, HALF_LIGHT_SRGB, 255);
+    QImage mip = downsampleImage(image, QSize(SIZE / 2, SIZE / 2), true);
+    QCOMPARE(mip.size(), QSize(SIZE / 2, SIZE / 2));
+    for (int y = 0; y < mip.height(); ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(mip.constScanLine(y));
+        for (int x = 0; x < mip.width(); ++x) {
+            if (line[x] != HALF_LIGHT) {
+                QFAIL(qPrintable(QString("texel %1, %2 is %3").arg(x).arg(y).arg(line[x], 8, 16)));
+            }
+        }
+    }
+}
+
+void TextureMipsTests::scaleAlphaToCoverageTest() {
+    // one texel of each alpha, half of them pass the alpha test
+    QImage mip(16, 16, QImage::Format_ARGB32);
+    for (int i = 0; i < 256; ++i) {
+        mip.setPixel(i % 16, i / 16, qRgba(255, 255, 255, i));
+    }
+    QCOMPARE(evalAlphaCoverage(mip), 0.5f);
+
+    scaleAlphaToCoverage(mip, 0.75f);
+    QCOMPARE(evalAlphaCoverage(mip), 0.75f);
+
+    // the fully transparent texels stay transparent
+    QCOMPARE(qAlpha(mip.pixel(0, 0)), 0);
+}
+
+void TextureMipsTests::downsampledAlphaCoverageTest() {
+    // opaque strands one texel wide every four columns, over a background fading in from transparent
+    const int SIZE = 64;
+    QImage image(SIZE, SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            image.setPixel(x, y, qRgba(255, 255, 255, (x % 4 == 0) ? 255 : y));
+        }
+    }
+    float coverage = evalAlphaCoverage(image);
+    QCOMPARE(coverage, 0.25f);
+
+    // averaged with their background, the strands drop below the alpha test
+    QImage mip = downsampleImage(image, QSize(SIZE / 4, SIZE / 4), false);
+    QCOMPARE(evalAlphaCoverage(mip), 0.0f);
+
+    scaleAlphaToCoverage(mip, coverage);
+    QCOMPARE(evalAlphaCoverage(mip), coverage);
+}
@@ -0,0 +1,37 @@
+//
+//  TextureMipsTests.h
+//  tests/model/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureMipsTests_h
+#define hifi_TextureMipsTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TextureMipsTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test the sRGB colors are averaged in linear space, and the linear colors as they are
+    void gammaCorrectBoxFilterTest();
+
+    // Test the transparent texels do not bleed their color into the mip
+    void alphaWeightedBoxFilterTest();
+
+    // Test a mip large enough to be split across threads is filtered the same everywhere
+    void threadedBoxFilterTest();
+
+    // Test the alpha of a mip is scaled to the coverage asked for
+    void scaleAlphaToCoverageTest();
+
+    // Test thin cutout strands that average below the alpha test keep their coverage in the mip
+    void downsampledAlphaCoverageTest();
+};
+
+#endif // hifi_TextureMipsTests_h
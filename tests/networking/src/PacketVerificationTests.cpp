@@ -0,0 +1,109 @@
+//
+//  PacketVerificationTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketVerificationTests.h"
+
+#include <NLPacket.h>
+#include <SipHash.h>
+
+QTEST_MAIN(PacketVerificationTests)
+
+static const QUuid CONNECTION_SECRET("{3d3e7c8b-5d2a-4d43-9a8e-0b2f6f1c9e21}");
+
+static std::unique_ptr<NLPacket> createVerifiedPacket(int payloadSize) {
+    auto packet = NLPacket::create(PacketType::AvatarData, payloadSize);
+    for (int i = 0; i < payloadSize; ++i) {
+        packet->writePrimitive((quint8)i);
+    }
+    packet->writeSourceID(QUuid::createUuid());
+    packet->writeVerificationHashGivenSecret(CONNECTION_SECRET);
+    return packet;
+}
+
+static void addPacketSizes() {
+    QTest::addColumn<int>("payloadSize");
+
+    QTest::newRow("audio") << 250;
+    QTest::newRow("avatar") << 600;
+    QTest::newRow("mtu") << NLPacket::maxPayloadSize(PacketType::AvatarData);
+}
+
+void PacketVerificationTests::sipHashTest() {
+    // key 00 01 .. 0f, and messages 00 01 .. of increasing length, from the SipHash reference implementation
+    const uint64_t KEY_0 = 0x0706050403020100ULL;
+    const uint64_t KEY_1 = 0x0f0e0d0c0b0a0908ULL;
+    uint8_t message[64];
+    for (int i = 0; i < 64; ++i) {
+        message[i] = (uint8_t)i;
+    }
+
+    uint8_t hash[NUM_BYTES_SIP_HASH_128];
+
+    sipHash128(KEY_0, KEY_1, message, 0, hash);
+    QCOMPARE(QByteArray((const char*)hash, NUM_BYTES_SIP_HASH_128).toHex(),
+             QByteArray("a3817f04ba25a8e66df67214c7550293"));
+
+    sipHash128(KEY_0, KEY_1, message, 1, hash);
+    QCOMPARE(QByteArray((const char*)hash, NUM_BYTES_SIP_HASH_128).toHex(),
+             QByteArray("da87c1d86b99af44347659119b22fc45"));
+
+    sipHash128(KEY_0, KEY_1, message, 15, hash);
+    QCOMPARE(QByteArray((const char*)hash, NUM_BYTES_SIP_HASH_128).toHex(),
+             QByteArray("5493e99933b0a8117e08ec0f97cfc3d9"));
+
+    sipHash128(KEY_0, KEY_1, message, 63, hash);
+    QCOMPARE(QByteArray((const char*)hash, NUM_BYTES_SIP_HASH_128).toHex(),
+             QByteArray("5150d1772f50834a503e069a973fbd7c"));
+}
+
+void PacketVerificationTests::verificationHashTest() {
+    auto packet = createVerifiedPacket(600);
+
+    QVERIFY(NLPacket::verificationHashMatches(*packet, CONNECTION_SECRET));
+    QCOMPARE(NLPacket::verificationHashInHeader(*packet), NLPacket::hashForPacketAndSecret(*packet, CONNECTION_SECRET));
+    QVERIFY(!NLPacket::verificationHashMatches(*packet, QUuid::createUuid()));
+
+    packet->getPayload()[300] ^= 1;
+    QVERIFY(!NLPacket::verificationHashMatches(*packet, CONNECTION_SECRET));
+}
+
+void PacketVerificationTests::benchmarkMD5_data() {
+    addPacketSizes();
+}
+
+void PacketVerificationTests::benchmarkMD5() {
+    QFETCH(int, payloadSize);
+    auto packet = createVerifiedPacket(payloadSize);
+
+    // the verification as it was before SipHash, header hash and secret copies included
+    int numMatches = 0;
+    QBENCHMARK {
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        hash.addData(packet->getPayload(), packet->getPayloadSize());
+        hash.addData(CONNECTION_SECRET.toRfc4122());
+        if (hash.result() == NLPacket::verificationHashInHeader(*packet)) {
+            ++numMatches;
+        }
+    }
+    Q_UNUSED(numMatches);
+}
+
+void PacketVerificationTests::benchmarkSipHash_data() {
+    addPacketSizes();
+}
+
+void PacketVerificationTests::benchmarkSipHash() {
+    QFETCH(int, payloadSize);
+    auto packet = createVerifiedPacket(payloadSize);
+
+    QBENCHMARK {
+        QVERIFY(NLPacket::verificationHashMatches(*packet, CONNECTION_SECRET));
+    }
+}
@@ -0,0 +1,34 @@
+//
+//  PacketVerificationTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketVerificationTests_h
+#define hifi_PacketVerificationTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketVerificationTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test SipHash-2-4-128 against the reference test vectors
+    void sipHashTest();
+
+    // Test a packet verifies against its own connection secret only, and not once altered
+    void verificationHashTest();
+
+    // Compare the MD5 and SipHash verification of audio, avatar and MTU sized packets
+    void benchmarkMD5_data();
+    void benchmarkMD5();
+    void benchmarkSipHash_data();
+    void benchmarkSipHash();
+};
+
+#endif // hifi_PacketVerificationTests_h
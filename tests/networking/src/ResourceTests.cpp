@@ -82,3 +82,36 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+void ResourceTests::pendingRequestPriority() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+
+    const int NUM_RESOURCES = 8;
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        auto pendingResource = QSharedPointer<Resource>::create(QUrl("atp:/pending/" + QString::number(i)));
+        pendingResource->setSelf(pendingResource);
+        pendingResource->setLoadPriority(&owner, (float)((i * 5) % NUM_RESOURCES));
+        sharedItems->appendPendingRequest(pendingResource);
+        resources.append(pendingResource);
+    }
+
+    // raise the priority of a pending request
+    resources[0]->setLoadPriority(&owner, (float)NUM_RESOURCES);
+    sharedItems->updatePendingRequest(resources[0]);
+
+    // raise another, then lose the owner that raised it
+    QObject* transientOwner = new QObject();
+    resources[1]->setLoadPriority(transientOwner, 100.0f);
+    sharedItems->updatePendingRequest(resources[1]);
+    delete transientOwner;
+
+    for (int i = NUM_RESOURCES; i > 0; i--) {
+        auto highestResource = sharedItems->getHighestPendingRequest();
+        QVERIFY(highestResource);
+        QCOMPARE(highestResource->getLoadPriority(), (float)i);
+    }
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+}
@@ -18,6 +18,7 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void pendingRequestPriority();
 };
 
 #endif // hifi_ResourceTests_h
@@ -0,0 +1,202 @@
+//
+//  EntityPersistTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPersistTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <AddressManager.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreePersistThread.h>
+
+QTEST_MAIN(EntityPersistTests)
+
+static const int NUM_ENTITIES = 3;
+
+static EntityTreePointer createServerTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static void addBox(const EntityTreePointer& tree, const QUuid& id, const QString& name) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName(name);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(tree->addEntity(EntityItemID(id), properties));
+}
+
+static QString getName(const EntityTreePointer& tree, const QUuid& id) {
+    auto entity = tree->findEntityByEntityItemID(EntityItemID(id));
+    return entity ? entity->getName() : QString();
+}
+
+// Writes a snapshot of three boxes, then appends the rename of the first, the delete of the second and the
+// add of a fourth, whose ids end up in ids.
+static void writeSnapshotAndLog(const QString& fileName, QVector<QUuid>& ids) {
+    auto tree = createServerTree();
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        ids << QUuid::createUuid();
+        addBox(tree, ids.back(), QString("box %1").arg(i));
+    }
+    QVERIFY2(tree->writeToBinaryFile(qPrintable(fileName)), "snapshot");
+    qint64 snapshotSize = QFileInfo(fileName).size();
+
+    auto first = tree->findEntityByEntityItemID(EntityItemID(ids[0]));
+    EntityItemProperties properties = first->getProperties();
+    properties.setName("renamed box");
+    QVERIFY(tree->updateEntity(EntityItemID(ids[0]), properties));
+    tree->deleteEntity(EntityItemID(ids[1]), true);
+    ids << QUuid::createUuid();
+    addBox(tree, ids.back(), "added box");
+    QVERIFY2(tree->writeToBinaryFile(qPrintable(fileName)), "log");
+
+    // the changes are appended after the snapshot, not written as a new one
+    QVERIFY(QFileInfo(fileName).size() > snapshotSize);
+}
+
+// Returns the bytes of a rename record, as appended to the log of another file
+static QByteArray createRenameRecord(const QString& fileName) {
+    auto tree = createServerTree();
+    QUuid id = QUuid::createUuid();
+    addBox(tree, id, "box");
+    tree->writeToBinaryFile(qPrintable(fileName));
+    qint64 snapshotSize = QFileInfo(fileName).size();
+
+    EntityItemProperties properties = tree->findEntityByEntityItemID(EntityItemID(id))->getProperties();
+    properties.setName("renamed again");
+    tree->updateEntity(EntityItemID(id), properties);
+    tree->writeToBinaryFile(qPrintable(fileName));
+
+    QFile file(fileName);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll().mid(snapshotSize);
+}
+
+static void verifyTree(const EntityTreePointer& tree, const QVector<QUuid>& ids) {
+    QCOMPARE(getName(tree, ids[0]), QString("renamed box"));
+    QVERIFY(!tree->findEntityByEntityItemID(EntityItemID(ids[1])));
+    QCOMPARE(getName(tree, ids[2]), QString("box 2"));
+    QCOMPARE(getName(tree, ids[3]), QString("added box"));
+}
+
+static void verifyReadBack(const QString& fileName, const QVector<QUuid>& ids) {
+    auto tree = createServerTree();
+    QVERIFY(tree->readFromBinaryFile(fileName));
+    verifyTree(tree, ids);
+}
+
+// Runs the initial load of the persist thread, without starting it
+class LoadingPersistThread : public OctreePersistThread {
+public:
+    using OctreePersistThread::OctreePersistThread;
+    void load() { process(); }
+};
+
+void EntityPersistTests::initTestCase() {
+    // adding entities requires the node list, even on the server
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void EntityPersistTests::binaryRoundTripTest() {
+    QTemporaryDir directory;
+    QString fileName = directory.filePath("models.bin");
+    QVector<QUuid> ids;
+    writeSnapshotAndLog(fileName, ids);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+    verifyReadBack(fileName, ids);
+}
+
+void EntityPersistTests::binaryTruncatedLogTest() {
+    QTemporaryDir directory;
+    QString fileName = directory.filePath("models.bin");
+    QVector<QUuid> ids;
+    writeSnapshotAndLog(fileName, ids);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    // a properties record cut short, as a crash while appending would leave it
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::Append));
+    const char TRUNCATED_RECORD[] = { 1, 0, 0, 0 };
+    file.write(TRUNCATED_RECORD, sizeof(TRUNCATED_RECORD));
+    file.close();
+
+    verifyReadBack(fileName, ids);
+}
+
+void EntityPersistTests::binaryCorruptLogTest() {
+    QTemporaryDir directory;
+    QString fileName = directory.filePath("models.bin");
+    QVector<QUuid> ids;
+    writeSnapshotAndLog(fileName, ids);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    // a record of an unknown type, followed by a delete of the first box that must not be applied
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::Append));
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    const quint8 UNKNOWN_RECORD = 0x7f;
+    const quint8 DELETED_RECORD = 2;
+    stream << UNKNOWN_RECORD << DELETED_RECORD << ids[0];
+    file.close();
+
+    verifyReadBack(fileName, ids);
+}
+
+void EntityPersistTests::binaryCrashedAppendTest() {
+    QTemporaryDir directory;
+    QString fileName = directory.filePath("models.bin");
+    QVector<QUuid> ids;
+    writeSnapshotAndLog(fileName, ids);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    // the server died halfway through appending a record, with the lock file of the other formats around
+    QByteArray record = createRenameRecord(directory.filePath("other.bin"));
+    QVERIFY(record.size() > 1);
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::Append));
+    file.write(record.left(record.size() / 2));
+    file.close();
+    QFile lockFile(fileName + ".lock");
+    QVERIFY(lockFile.open(QIODevice::WriteOnly));
+    lockFile.close();
+
+    // and an older backup, without any of the changes, is there to be restored
+    QVERIFY(createServerTree()->writeToBinaryFile(qPrintable(fileName + ".backup.1")));
+    QJsonObject backupRule;
+    backupRule["Name"] = "Rolling Backups";
+    backupRule["format"] = ".backup.%N";
+    backupRule["backupInterval"] = 3600;
+    backupRule["maxBackupVersions"] = 1;
+    QJsonObject settings;
+    settings["backups"] = QJsonArray({ backupRule });
+
+    auto tree = createServerTree();
+    LoadingPersistThread persistThread(tree, fileName, directory.path(), OctreePersistThread::DEFAULT_PERSIST_INTERVAL,
+                                       true, settings, false, "bin");
+    persistThread.load();
+    QVERIFY(persistThread.isInitialLoadComplete());
+    QVERIFY(!QFile::exists(fileName + ".lock"));
+    verifyTree(tree, ids);
+}
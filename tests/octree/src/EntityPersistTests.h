@@ -0,0 +1,33 @@
+//
+//  EntityPersistTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPersistTests_h
+#define hifi_EntityPersistTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPersistTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Test a snapshot followed by an appended log of changes and deletes reads back as the tree that wrote them
+    void binaryRoundTripTest();
+
+    // Test the complete records before a truncated or unknown trailing record are still read
+    void binaryTruncatedLogTest();
+    void binaryCorruptLogTest();
+
+    // Test a crash halfway through an append loads the snapshot and log as they were, rather than the last backup
+    void binaryCrashedAppendTest();
+};
+
+#endif // hifi_EntityPersistTests_h